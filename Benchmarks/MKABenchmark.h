@@ -0,0 +1,75 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKABenchmark_h
+#define MKABenchmark_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/*
+ * A minimal benchmark harness. Each case runs a closed cycle of operations, so the state is the same
+ * before and after each iteration, and reports the average time per operation.
+ */
+
+/**
+ * Receives the results of the measured operations, so the compiler does not remove them.
+ */
+static volatile uint64_t MKABenchmarkSink = 0;
+
+static inline double MKABenchmarkNow(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double) time.tv_sec + (double) time.tv_nsec / 1e9;
+}
+
+/**
+ * Returns the number of the iterations given as the first argument, or `defaultCount`.
+ */
+static inline unsigned long MKABenchmarkIterationCount(int argc, char *argv[], unsigned long defaultCount) {
+    const unsigned long count = argc > 1 ? strtoul(argv[1], NULL, 10) : 0;
+    return count > 0 ? count : defaultCount;
+}
+
+static inline void MKABenchmarkReport(const char *name, double elapsedTime, unsigned long iterationCount, unsigned operationCount) {
+    printf("%-48s %10.2f ns/op\n", name, elapsedTime / (double) iterationCount / (double) operationCount * 1e9);
+}
+
+/**
+ * Runs the statement `iterationCount` times and reports the time per operation.
+ * The statement performs `operationCount` operations. It is variadic, so it may contain commas.
+ */
+#define MKABenchmarkRun(name, iterationCount, operationCount, ...) \
+    do { \
+        const double startTime = MKABenchmarkNow(); \
+        for (unsigned long iteration = 0; iteration < (iterationCount); iteration++) { \
+            __VA_ARGS__; \
+        } \
+        MKABenchmarkReport((name), MKABenchmarkNow() - startTime, (iterationCount), (operationCount)); \
+    } while (0)
+
+#endif /* MKABenchmark_h */
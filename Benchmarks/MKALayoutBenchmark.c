@@ -0,0 +1,75 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKABenchmark.h"
+#include "MKALayout.h"
+
+enum {
+    kStackCount = 16,
+};
+
+int main(int argc, char *argv[]) {
+    const unsigned long iterationCount = MKABenchmarkIterationCount(argc, argv, 10000000);
+    const MKALayoutInsets safeArea = { 47, 0, 34, 0 };
+    // Varies the container, so the compiler can not hoist the layout out of the loop.
+    volatile double containerWidth = 390;
+    double heights[kStackCount];
+    double offsets[kStackCount];
+
+    for (int i = 0; i < kStackCount; i++) {
+        heights[i] = 40 + i * 4;
+    }
+
+    MKABenchmarkRun("popup view", iterationCount, 1, {
+        MKAPopupViewLayout layout = MKALayoutPopupView((MKALayoutSize) { containerWidth, 480 }, (MKALayoutSize) { 120, 50 });
+        MKABenchmarkSink += (uint64_t) layout.containerFrame.size.height;
+    });
+
+    MKABenchmarkRun("popup clamp and center", iterationCount, 1, {
+        const MKALayoutSize container = { containerWidth, 844 };
+        MKALayoutSize size = MKALayoutClampPopupSize((MKALayoutSize) { 320, 480 }, container, safeArea);
+        MKALayoutPoint center = MKALayoutPopupCenter(container, safeArea);
+        MKABenchmarkSink += (uint64_t) (center.x - size.width / 2.0);
+    });
+
+    MKABenchmarkRun("bottom sheet", iterationCount, 1, {
+        MKALayoutRect frame = MKALayoutBottomSheet((MKALayoutSize) { containerWidth, 844 }, 300, safeArea);
+        MKABenchmarkSink += (uint64_t) frame.origin.y;
+    });
+
+    MKABenchmarkRun("toast label and center", iterationCount, 1, {
+        const MKALayoutSize toastSize = { containerWidth - 90, 80 };
+        MKALayoutRect label = MKALayoutToastLabel(toastSize, (MKALayoutSize) { MKALayoutToastLabelWidth(toastSize.width, 16), 20 });
+        MKALayoutPoint center = MKALayoutToastCenter((MKALayoutSize) { containerWidth, 844 }, toastSize, 64, safeArea);
+        MKABenchmarkSink += (uint64_t) (label.origin.x + center.y);
+    });
+
+    MKABenchmarkRun("toast stack of 16", iterationCount, kStackCount, {
+        heights[0] = containerWidth / 8;
+        MKALayoutToastStack(heights, kStackCount, 8, offsets);
+        MKABenchmarkSink += (uint64_t) offsets[kStackCount - 1];
+    });
+
+    return 0;
+}
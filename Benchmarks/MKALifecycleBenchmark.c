@@ -0,0 +1,110 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKABenchmark.h"
+#include "MKALifecycle.h"
+
+static void benchmarkPopup(unsigned long iterationCount) {
+    MKAPopupState state = MKAPopupStateHidden;
+
+    MKABenchmarkRun("popup show, finished, hide, finished", iterationCount, 4, {
+        MKABenchmarkSink += MKAPopupStateHandle(&state, MKAPopupEventShow);
+        MKABenchmarkSink += MKAPopupStateHandle(&state, MKAPopupEventShowFinished);
+        MKABenchmarkSink += MKAPopupStateHandle(&state, MKAPopupEventHide);
+        MKABenchmarkSink += MKAPopupStateHandle(&state, MKAPopupEventHideFinished);
+    });
+
+    MKAPopupStateHandle(&state, MKAPopupEventShow);
+
+    MKABenchmarkRun("popup illegal show", iterationCount, 1, {
+        MKABenchmarkSink += MKAPopupStateHandle(&state, MKAPopupEventShow);
+    });
+}
+
+static void benchmarkToast(unsigned long iterationCount) {
+    MKAToastLifecycle lifecycle;
+    double delay;
+    double now = 0;
+
+    MKAToastLifecycleInit(&lifecycle, 2);
+
+    MKABenchmarkRun("toast show, fade in, hide, fade out", iterationCount, 4, {
+        MKABenchmarkSink += MKAToastLifecycleShow(&lifecycle);
+        MKABenchmarkSink += MKAToastLifecycleFadeInFinished(&lifecycle, now, &delay);
+        MKABenchmarkSink += MKAToastLifecycleHide(&lifecycle, false);
+        MKABenchmarkSink += MKAToastLifecycleFadeOutFinished(&lifecycle);
+    });
+
+    MKAToastLifecycleShow(&lifecycle);
+    MKAToastLifecycleFadeInFinished(&lifecycle, now, &delay);
+
+    MKABenchmarkRun("toast suspend, resume", iterationCount, 2, {
+        now += 0.001;
+        MKABenchmarkSink += MKAToastLifecycleSuspend(&lifecycle, now);
+        MKABenchmarkSink += MKAToastLifecycleResume(&lifecycle, now, &delay);
+    });
+
+    MKABenchmarkRun("toast cancel, show", iterationCount, 2, {
+        MKABenchmarkSink += MKAToastLifecycleCancel(&lifecycle);
+        MKABenchmarkSink += MKAToastLifecycleShow(&lifecycle);
+    });
+}
+
+static void benchmarkIndicator(unsigned long iterationCount) {
+    MKAIndicatorLifecycle lifecycle;
+    double delay;
+
+    MKAIndicatorLifecycleInit(&lifecycle);
+    lifecycle.gracePeriod = 1;
+    lifecycle.minimumDisplayTime = 2;
+
+    MKABenchmarkRun("indicator show, grace, hide, minimum", iterationCount, 4, {
+        MKABenchmarkSink += MKAIndicatorLifecycleShow(&lifecycle, 0, true, &delay);
+        MKABenchmarkSink += MKAIndicatorLifecycleGracePeriodElapsed(&lifecycle, 1);
+        MKABenchmarkSink += MKAIndicatorLifecycleHide(&lifecycle, 2, &delay);
+        MKABenchmarkSink += MKAIndicatorLifecycleMinimumDisplayTimeElapsed(&lifecycle);
+    });
+
+    MKABenchmarkRun("indicator show, hide forcibly", iterationCount, 2, {
+        MKABenchmarkSink += MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay);
+        MKABenchmarkSink += MKAIndicatorLifecycleHideForcibly(&lifecycle);
+    });
+
+    MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay);
+
+    MKABenchmarkRun("indicator nested show, hide", iterationCount, 2, {
+        MKABenchmarkSink += MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay);
+        MKABenchmarkSink += MKAIndicatorLifecycleHide(&lifecycle, 0, &delay);
+    });
+}
+
+int main(int argc, char *argv[]) {
+    const unsigned long iterationCount = MKABenchmarkIterationCount(argc, argv, 10000000);
+
+    benchmarkPopup(iterationCount);
+    benchmarkToast(iterationCount);
+    benchmarkIndicator(iterationCount);
+
+    return 0;
+}
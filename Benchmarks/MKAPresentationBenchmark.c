@@ -0,0 +1,58 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKABenchmark.h"
+#include "MKAPopupPresentation.h"
+
+static char _rootView, _popup, _popupView;
+
+static void MKABenchmarkPresentation(const char *name, const MKARenderBackend *backend, unsigned long iterationCount) {
+    const MKALayoutSize rootSize = { 390, 844 };
+    const MKALayoutInsets safeArea = { 47, 0, 34, 0 };
+    MKAPopupPresentation presentation;
+
+    MKAPopupPresentationInit(&presentation, &_popup, &_popupView, MKAPopupPlacementCenter);
+    presentation.popupSize = (MKALayoutSize) { 320, 480 };
+
+    MKABenchmarkRun(name, iterationCount, 4, {
+        MKABenchmarkSink += MKAPopupPresentationShow(&presentation, backend, &_rootView, rootSize, safeArea, 0.3);
+        MKABenchmarkSink += MKAPopupPresentationShowFinished(&presentation);
+        MKABenchmarkSink += MKAPopupPresentationHide(&presentation, backend, 0.3);
+        MKABenchmarkSink += MKAPopupPresentationHideFinished(&presentation, backend);
+    });
+}
+
+int main(int argc, char *argv[]) {
+    const unsigned long iterationCount = MKABenchmarkIterationCount(argc, argv, 10000000);
+    const MKARenderBackend nullBackend = MKARenderBackendNull();
+    MKARenderRecorder recorder;
+
+    MKARenderRecorderInit(&recorder, NULL, 0, NULL);
+    const MKARenderBackend recorderBackend = MKARenderRecorderBackend(&recorder);
+
+    MKABenchmarkPresentation("popup presentation, null backend", &nullBackend, iterationCount);
+    MKABenchmarkPresentation("popup presentation, recorder backend", &recorderBackend, iterationCount);
+
+    return recorder.counts.insertions == iterationCount ? 0 : 1;
+}
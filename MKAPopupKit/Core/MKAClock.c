@@ -0,0 +1,166 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKAClock.h"
+
+// MARK: - clock
+
+double MKAClockNow(const MKAClock *clock) {
+    return clock && clock->now ? clock->now(clock->context) : 0;
+}
+
+MKAClockTimer MKAClockSchedule(const MKAClock *clock, double delay, MKAClockCallback callback, void *info) {
+    if (!clock || !clock->schedule || !callback) {
+        return 0;
+    }
+
+    return clock->schedule(clock->context, delay > 0 ? delay : 0, callback, info);
+}
+
+void MKAClockCancel(const MKAClock *clock, MKAClockTimer timer) {
+    if (clock && clock->cancel && timer != 0) {
+        clock->cancel(clock->context, timer);
+    }
+}
+
+// MARK: - virtual clock
+
+static double MKAVirtualClockNow(void *context) {
+    return ((MKAVirtualClock *) context)->time;
+}
+
+static MKAClockTimer MKAVirtualClockSchedule(void *context, double delay, MKAClockCallback callback, void *info) {
+    MKAVirtualClock *clock = context;
+
+    if (clock->count >= clock->capacity) {
+        return 0;
+    }
+
+    MKAVirtualTimer *timer = &clock->timers[clock->count++];
+    timer->timer = ++clock->lastTimer;
+    timer->fireTime = clock->time + delay;
+    timer->callback = callback;
+    timer->info = info;
+
+    return timer->timer;
+}
+
+static void MKAVirtualClockRemoveAt(MKAVirtualClock *clock, size_t index) {
+    // Keeps the order of the rest, so the timers due at the same time fire in the scheduled order.
+    for (size_t i = index + 1; i < clock->count; i++) {
+        clock->timers[i - 1] = clock->timers[i];
+    }
+
+    clock->count--;
+}
+
+static void MKAVirtualClockCancel(void *context, MKAClockTimer timer) {
+    MKAVirtualClock *clock = context;
+
+    for (size_t i = 0; i < clock->count; i++) {
+        if (clock->timers[i].timer == timer) {
+            MKAVirtualClockRemoveAt(clock, i);
+            return;
+        }
+    }
+}
+
+/**
+ * Returns the index of the earliest timer, or `count` if no timer is pending.
+ */
+static size_t MKAVirtualClockEarliestIndex(const MKAVirtualClock *clock) {
+    size_t earliest = clock->count;
+
+    for (size_t i = 0; i < clock->count; i++) {
+        if (earliest == clock->count || clock->timers[i].fireTime < clock->timers[earliest].fireTime) {
+            earliest = i;
+        }
+    }
+
+    return earliest;
+}
+
+void MKAVirtualClockInit(MKAVirtualClock *clock, MKAVirtualTimer *timers, size_t capacity, double time) {
+    clock->time = time;
+    clock->timers = timers;
+    clock->capacity = timers ? capacity : 0;
+    clock->count = 0;
+    clock->lastTimer = 0;
+}
+
+MKAClock MKAVirtualClockMakeClock(MKAVirtualClock *clock) {
+    MKAClock result;
+
+    result.context = clock;
+    result.now = MKAVirtualClockNow;
+    result.schedule = MKAVirtualClockSchedule;
+    result.cancel = MKAVirtualClockCancel;
+
+    return result;
+}
+
+size_t MKAVirtualClockAdvance(MKAVirtualClock *clock, double interval) {
+    const double endTime = clock->time + (interval > 0 ? interval : 0);
+    size_t fired = 0;
+
+    for (;;) {
+        const size_t index = MKAVirtualClockEarliestIndex(clock);
+
+        if (index == clock->count || clock->timers[index].fireTime > endTime) {
+            break;
+        }
+
+        // Removes the timer before the callback, which may schedule or cancel other timers.
+        const MKAVirtualTimer timer = clock->timers[index];
+        MKAVirtualClockRemoveAt(clock, index);
+
+        if (timer.fireTime > clock->time) {
+            clock->time = timer.fireTime;
+        }
+
+        timer.callback(timer.info);
+        fired++;
+    }
+
+    clock->time = endTime;
+
+    return fired;
+}
+
+size_t MKAVirtualClockRunUntilIdle(MKAVirtualClock *clock, double limit) {
+    const double endTime = clock->time + (limit > 0 ? limit : 0);
+    size_t fired = 0;
+
+    while (clock->count > 0) {
+        const double fireTime = clock->timers[MKAVirtualClockEarliestIndex(clock)].fireTime;
+
+        if (fireTime > endTime) {
+            break;
+        }
+
+        fired += MKAVirtualClockAdvance(clock, fireTime - clock->time);
+    }
+
+    return fired;
+}
@@ -0,0 +1,121 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKAClock_h
+#define MKAClock_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The source of the time and the timers of the components.
+ * The UIKit adapters read the time and schedule the hold times, the delays, the ends of the fades and the grace periods
+ * through the current clock, so the lifecycles can run on a virtual time that is advanced by hand.
+ */
+
+/**
+ * An identifier of a scheduled timer. Zero is never used for a valid timer.
+ */
+typedef uint64_t MKAClockTimer;
+
+typedef void (*MKAClockCallback)(void *info);
+
+typedef struct MKAClock {
+    void *context;
+    /**
+     * Returns the current time in seconds.
+     */
+    double (*now)(void *context);
+    /**
+     * Calls the callback once after the delay in seconds. Returns zero if the timer can not be scheduled.
+     */
+    MKAClockTimer (*schedule)(void *context, double delay, MKAClockCallback callback, void *info);
+    /**
+     * Cancels the timer not fired yet. Does nothing for a fired or canceled timer.
+     */
+    void (*cancel)(void *context, MKAClockTimer timer);
+} MKAClock;
+
+typedef struct MKAVirtualTimer {
+    MKAClockTimer timer;
+    double fireTime;
+    MKAClockCallback callback;
+    void *info;
+} MKAVirtualTimer;
+
+typedef struct MKAVirtualClock {
+    double time;
+    /**
+     * A buffer of the pending timers given by the caller.
+     */
+    MKAVirtualTimer *timers;
+    size_t capacity;
+    size_t count;
+    MKAClockTimer lastTimer;
+} MKAVirtualClock;
+
+// MARK: - clock
+
+double MKAClockNow(const MKAClock *clock);
+MKAClockTimer MKAClockSchedule(const MKAClock *clock, double delay, MKAClockCallback callback, void *info);
+void MKAClockCancel(const MKAClock *clock, MKAClockTimer timer);
+
+// MARK: - virtual clock
+
+/**
+ * Initializes the virtual clock.
+ *
+ * @param timers A buffer to store the pending timers.
+ * @param capacity The number of the elements of the buffer. Timers beyond it are not scheduled.
+ * @param time The time where the clock starts.
+ */
+void MKAVirtualClockInit(MKAVirtualClock *clock, MKAVirtualTimer *timers, size_t capacity, double time);
+/**
+ * Returns the clock that reads the time and schedules the timers on the virtual clock.
+ * The virtual clock must outlive the returned clock.
+ */
+MKAClock MKAVirtualClockMakeClock(MKAVirtualClock *clock);
+/**
+ * Moves the time forward by given interval and fires the timers due in the order of their fire times.
+ * Timers scheduled by the callbacks are fired too if they become due within the interval.
+ *
+ * @return The number of the fired timers.
+ */
+size_t MKAVirtualClockAdvance(MKAVirtualClock *clock, double interval);
+/**
+ * Moves the time forward until no timer is pending, or until `limit` seconds have passed.
+ *
+ * @return The number of the fired timers.
+ */
+size_t MKAVirtualClockRunUntilIdle(MKAVirtualClock *clock, double limit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKAClock_h */
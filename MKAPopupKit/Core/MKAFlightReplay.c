@@ -0,0 +1,256 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKAFlightReplay.h"
+
+#include <string.h>
+
+// MARK: - event types
+
+MKAFlightReplayKind MKAFlightReplayKindOfType(uint16_t type) {
+    if (type >= MKAFlightEventTypePopupShow && type <= MKAFlightEventTypePopupDidDisappear) {
+        return MKAFlightReplayKindPopup;
+    }
+
+    if (type >= MKAFlightEventTypeToastShow && type <= MKAFlightEventTypeToastDequeue) {
+        return MKAFlightReplayKindToast;
+    }
+
+    if (type >= MKAFlightEventTypeIndicatorShow && type <= MKAFlightEventTypeIndicatorMinimumDisplayTimeElapsed) {
+        return MKAFlightReplayKindIndicator;
+    }
+
+    return MKAFlightReplayKindNone;
+}
+
+const char *MKAFlightReplayNameOfType(uint16_t type) {
+    switch ((MKAFlightEventType) type) {
+        case MKAFlightEventTypePopupShow: return "popup show";
+        case MKAFlightEventTypePopupShowFinished: return "popup show finished";
+        case MKAFlightEventTypePopupHide: return "popup hide";
+        case MKAFlightEventTypePopupHideFinished: return "popup hide finished";
+        case MKAFlightEventTypePopupDidAppear: return "popup did appear";
+        case MKAFlightEventTypePopupDidDisappear: return "popup did disappear";
+        case MKAFlightEventTypeToastShow: return "toast show";
+        case MKAFlightEventTypeToastFadeInFinished: return "toast fade in finished";
+        case MKAFlightEventTypeToastHide: return "toast hide";
+        case MKAFlightEventTypeToastFadeOutFinished: return "toast fade out finished";
+        case MKAFlightEventTypeToastSuspend: return "toast suspend";
+        case MKAFlightEventTypeToastResume: return "toast resume";
+        case MKAFlightEventTypeToastCancel: return "toast cancel";
+        case MKAFlightEventTypeToastDidAppear: return "toast did appear";
+        case MKAFlightEventTypeToastDidDisappear: return "toast did disappear";
+        case MKAFlightEventTypeToastEnqueue: return "toast enqueue";
+        case MKAFlightEventTypeToastDequeue: return "toast dequeue";
+        case MKAFlightEventTypeIndicatorShow: return "indicator show";
+        case MKAFlightEventTypeIndicatorHide: return "indicator hide";
+        case MKAFlightEventTypeIndicatorHideForcibly: return "indicator hide forcibly";
+        case MKAFlightEventTypeIndicatorGracePeriodElapsed: return "indicator grace period elapsed";
+        case MKAFlightEventTypeIndicatorMinimumDisplayTimeElapsed: return "indicator minimum display time elapsed";
+    }
+
+    return "unknown";
+}
+
+// MARK: - components
+
+/**
+ * Returns the component of the object, or NULL if the table is full of other components.
+ */
+static MKAFlightReplayComponent *MKAFlightReplayFindComponent(MKAFlightReplay *replay, uint64_t object) {
+    // The addresses are aligned, so the low bits are mixed into the index.
+    const uint64_t hash = object * UINT64_C(0x9E3779B97F4A7C15);
+    size_t index = (size_t) (hash >> 32) & (replay->capacity - 1);
+
+    for (size_t i = 0; i < replay->capacity; i++) {
+        MKAFlightReplayComponent *component = &replay->components[index];
+
+        if (component->kind == MKAFlightReplayKindNone || component->object == object) {
+            component->object = object;
+            return component;
+        }
+
+        index = (index + 1) & (replay->capacity - 1);
+    }
+
+    return NULL;
+}
+
+/**
+ * Tells whether the recorded call started the lifecycle from the initial state, so the replay can follow it.
+ */
+static bool MKAFlightReplayStartsLifecycle(const MKAFlightEvent *event) {
+    switch ((MKAFlightEventType) event->type) {
+        case MKAFlightEventTypePopupShow:
+        case MKAFlightEventTypeToastShow:
+            return event->result != 0;
+        case MKAFlightEventTypeIndicatorShow:
+            return event->result == MKAIndicatorActionPresent || event->result == MKAIndicatorActionSchedulePresent;
+        default:
+            return false;
+    }
+}
+
+// MARK: - replay
+
+/**
+ * Replays the event of a popup.
+ *
+ * @return true if the recorded result is reproduced.
+ */
+static bool MKAFlightReplayPopup(MKAPopupState *state, const MKAFlightEvent *event) {
+    if (event->type > MKAFlightEventTypePopupHideFinished) {
+        // The delegate callbacks are not the inputs.
+        return true;
+    }
+
+    const MKAPopupEvent popupEvent = (MKAPopupEvent) (event->type - MKAFlightEventTypePopupShow);
+
+    return MKAPopupStateHandle(state, popupEvent) == (event->result != 0);
+}
+
+static bool MKAFlightReplayToast(MKAToastLifecycle *lifecycle, const MKAFlightEvent *event) {
+    double delay;
+
+    switch ((MKAFlightEventType) event->type) {
+        case MKAFlightEventTypeToastShow:
+            lifecycle->holdTime = event->value;
+            return MKAToastLifecycleShow(lifecycle) == (event->result != 0);
+        case MKAFlightEventTypeToastFadeInFinished:
+            return MKAToastLifecycleFadeInFinished(lifecycle, event->time, &delay) == (event->result != 0);
+        case MKAFlightEventTypeToastHide:
+            return MKAToastLifecycleHide(lifecycle, event->flags != 0) == (event->result != 0);
+        case MKAFlightEventTypeToastFadeOutFinished:
+            return MKAToastLifecycleFadeOutFinished(lifecycle) == (event->result != 0);
+        case MKAFlightEventTypeToastSuspend:
+            return MKAToastLifecycleSuspend(lifecycle, event->time) == (event->result != 0);
+        case MKAFlightEventTypeToastResume:
+            return MKAToastLifecycleResume(lifecycle, event->time, &delay) == (event->result != 0);
+        case MKAFlightEventTypeToastCancel:
+            return MKAToastLifecycleCancel(lifecycle) == (MKAToastState) event->result;
+        default:
+            // The delegate callbacks and the queue of the stack are not the inputs.
+            return true;
+    }
+}
+
+static bool MKAFlightReplayIndicator(MKAIndicatorLifecycle *lifecycle, const MKAFlightEvent *event) {
+    MKAIndicatorAction action = MKAIndicatorActionNone;
+    double delay;
+
+    // The properties may be changed between the calls.
+    lifecycle->gracePeriod = event->value;
+    lifecycle->minimumDisplayTime = event->secondValue;
+
+    switch ((MKAFlightEventType) event->type) {
+        case MKAFlightEventTypeIndicatorShow:
+            action = MKAIndicatorLifecycleShow(lifecycle, event->time, event->flags != 0, &delay);
+            break;
+        case MKAFlightEventTypeIndicatorHide:
+            action = MKAIndicatorLifecycleHide(lifecycle, event->time, &delay);
+            break;
+        case MKAFlightEventTypeIndicatorHideForcibly:
+            action = MKAIndicatorLifecycleHideForcibly(lifecycle);
+            break;
+        case MKAFlightEventTypeIndicatorGracePeriodElapsed:
+            action = MKAIndicatorLifecycleGracePeriodElapsed(lifecycle, event->time);
+            break;
+        case MKAFlightEventTypeIndicatorMinimumDisplayTimeElapsed:
+            action = MKAIndicatorLifecycleMinimumDisplayTimeElapsed(lifecycle);
+            break;
+        default:
+            return true;
+    }
+
+    return action == (MKAIndicatorAction) event->result && lifecycle->count == event->count;
+}
+
+void MKAFlightReplayInit(MKAFlightReplay *replay, MKAFlightReplayComponent *components, size_t capacity) {
+    replay->components = components;
+    replay->capacity = components ? capacity : 0;
+    MKAFlightReplayReset(replay);
+}
+
+void MKAFlightReplayReset(MKAFlightReplay *replay) {
+    if (replay->capacity > 0) {
+        memset(replay->components, 0, replay->capacity * sizeof(MKAFlightReplayComponent));
+    }
+}
+
+MKAFlightReplayResult MKAFlightReplayEvent(MKAFlightReplay *replay, const MKAFlightEvent *event) {
+    const MKAFlightReplayKind kind = MKAFlightReplayKindOfType(event->type);
+
+    if (kind == MKAFlightReplayKindNone) {
+        return MKAFlightReplayResultUnknown;
+    }
+
+    MKAFlightReplayComponent *component = MKAFlightReplayFindComponent(replay, event->object);
+
+    if (!component) {
+        return MKAFlightReplayResultSkipped;
+    }
+
+    if (component->kind != kind || !component->isTracked) {
+        // A new component, another component at the address of a deallocated one, or a component whose earlier
+        // events were overwritten.
+        component->kind = kind;
+        component->isTracked = MKAFlightReplayStartsLifecycle(event);
+
+        switch (kind) {
+            case MKAFlightReplayKindPopup:
+                component->popup = MKAPopupStateHidden;
+                break;
+            case MKAFlightReplayKindToast:
+                MKAToastLifecycleInit(&component->toast, event->value);
+                break;
+            case MKAFlightReplayKindIndicator:
+                MKAIndicatorLifecycleInit(&component->indicator);
+                break;
+            case MKAFlightReplayKindNone:
+                break;
+        }
+    }
+
+    if (!component->isTracked) {
+        return MKAFlightReplayResultSkipped;
+    }
+
+    bool isReproduced = true;
+
+    switch (kind) {
+        case MKAFlightReplayKindPopup:
+            isReproduced = MKAFlightReplayPopup(&component->popup, event);
+            break;
+        case MKAFlightReplayKindToast:
+            isReproduced = MKAFlightReplayToast(&component->toast, event);
+            break;
+        case MKAFlightReplayKindIndicator:
+            isReproduced = MKAFlightReplayIndicator(&component->indicator, event);
+            break;
+        case MKAFlightReplayKindNone:
+            break;
+    }
+
+    return isReproduced ? MKAFlightReplayResultReproduced : MKAFlightReplayResultMismatched;
+}
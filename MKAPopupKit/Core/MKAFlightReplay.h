@@ -0,0 +1,115 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKAFlightReplay_h
+#define MKAFlightReplay_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "MKAFlightRing.h"
+#include "MKALifecycle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Replays the recorded events through the lifecycle functions, and tells whether each recorded result is reproduced.
+ * A component is replayed from the first show that starts its lifecycle. The events before it are skipped,
+ * since the earlier events may have been overwritten in the ring buffer. It does not allocate: the table of the
+ * components is a buffer given by the caller.
+ */
+
+typedef enum MKAFlightReplayKind {
+    MKAFlightReplayKindNone = 0,
+    MKAFlightReplayKindPopup,
+    MKAFlightReplayKindToast,
+    MKAFlightReplayKindIndicator,
+} MKAFlightReplayKind;
+
+typedef enum MKAFlightReplayResult {
+    MKAFlightReplayResultReproduced = 0,
+    MKAFlightReplayResultMismatched,
+    /**
+     * The event of a component whose lifecycle has not been started in the events.
+     */
+    MKAFlightReplayResultSkipped,
+    /**
+     * The event of an unknown type.
+     */
+    MKAFlightReplayResultUnknown,
+} MKAFlightReplayResult;
+
+typedef struct MKAFlightReplayComponent {
+    uint64_t object;
+    MKAFlightReplayKind kind;
+    bool isTracked;
+    union {
+        MKAPopupState popup;
+        MKAToastLifecycle toast;
+        MKAIndicatorLifecycle indicator;
+    };
+} MKAFlightReplayComponent;
+
+typedef struct MKAFlightReplay {
+    /**
+     * An open addressing table of the components. The number of them is a power of two.
+     */
+    MKAFlightReplayComponent *components;
+    size_t capacity;
+} MKAFlightReplay;
+
+/**
+ * Returns the kind of the component that records given type of events.
+ */
+MKAFlightReplayKind MKAFlightReplayKindOfType(uint16_t type);
+/**
+ * Returns the name of given type of events, or "unknown".
+ */
+const char *MKAFlightReplayNameOfType(uint16_t type);
+/**
+ * Initializes the replay with no component.
+ *
+ * @param components A buffer of the components.
+ * @param capacity The number of the elements of the buffer. It must be a power of two. Twice as large as the number of
+ *                 the events is enough for any dump.
+ */
+void MKAFlightReplayInit(MKAFlightReplay *replay, MKAFlightReplayComponent *components, size_t capacity);
+/**
+ * Forgets all components, so the events can be replayed again.
+ */
+void MKAFlightReplayReset(MKAFlightReplay *replay);
+/**
+ * Replays the next event. The events must be given in the recorded order.
+ * The events of the components beyond the capacity are skipped.
+ */
+MKAFlightReplayResult MKAFlightReplayEvent(MKAFlightReplay *replay, const MKAFlightEvent *event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKAFlightReplay_h */
@@ -0,0 +1,132 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKAFlightRing.h"
+
+#include <stdio.h>
+#include <string.h>
+
+const char MKAFlightDumpMagic[8] = { 'M', 'K', 'A', 'F', 'L', 'T', 'R', 'C' };
+const uint32_t MKAFlightDumpVersion = 1;
+
+/**
+ * Reads the event at given index. Returns false if it has been overwritten or is being written.
+ */
+static bool MKAFlightRingReadEvent(MKAFlightRing *ring, uint64_t index, MKAFlightEvent *event) {
+    MKAFlightSlot *slot = &ring->slots[index & (ring->capacity - 1)];
+    const uint64_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    if (sequence != 2 * index + 2) {
+        return false;
+    }
+
+    *event = slot->event;
+    atomic_thread_fence(memory_order_acquire);
+
+    return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == sequence;
+}
+
+/**
+ * Returns the index of the oldest event that can remain in the buffer.
+ */
+static uint64_t MKAFlightRingFirstIndex(const MKAFlightRing *ring, uint64_t head) {
+    return head > ring->capacity ? head - ring->capacity : 0;
+}
+
+void MKAFlightRingInit(MKAFlightRing *ring, MKAFlightSlot *slots, size_t capacity) {
+    ring->slots = slots;
+    ring->capacity = capacity;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->isEnabled, false);
+
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&slots[i].sequence, 0);
+    }
+}
+
+void MKAFlightRingSetEnabled(MKAFlightRing *ring, bool isEnabled) {
+    atomic_store_explicit(&ring->isEnabled, isEnabled, memory_order_relaxed);
+}
+
+void MKAFlightRingRecord(MKAFlightRing *ring, const MKAFlightEvent *event) {
+    if (!atomic_load_explicit(&ring->isEnabled, memory_order_relaxed) || ring->capacity == 0) {
+        return;
+    }
+
+    // Each writer owns its slot by the index, so concurrent writers never wait for each other.
+    const uint64_t index = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    MKAFlightSlot *slot = &ring->slots[index & (ring->capacity - 1)];
+
+    atomic_store_explicit(&slot->sequence, 2 * index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->event = *event;
+    atomic_store_explicit(&slot->sequence, 2 * index + 2, memory_order_release);
+}
+
+size_t MKAFlightRingCopyEvents(MKAFlightRing *ring, MKAFlightEvent *events, size_t capacity) {
+    const uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    size_t count = 0;
+
+    for (uint64_t index = MKAFlightRingFirstIndex(ring, head); index < head && count < capacity; index++) {
+        if (MKAFlightRingReadEvent(ring, index, &events[count])) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool MKAFlightRingWriteFile(MKAFlightRing *ring, const char *path) {
+    FILE *file = fopen(path, "wb");
+
+    if (!file) {
+        return false;
+    }
+
+    const uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    MKAFlightDumpHeader header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MKAFlightDumpMagic, sizeof(header.magic));
+    header.version = MKAFlightDumpVersion;
+    header.eventSize = (uint32_t) sizeof(MKAFlightEvent);
+
+    // Writes the header again after the events, when the number of the readable events is known.
+    bool isSucceeded = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    for (uint64_t index = MKAFlightRingFirstIndex(ring, head); isSucceeded && index < head; index++) {
+        MKAFlightEvent event;
+
+        if (MKAFlightRingReadEvent(ring, index, &event)) {
+            isSucceeded = fwrite(&event, sizeof(event), 1, file) == 1;
+            header.eventCount++;
+        }
+    }
+
+    if (isSucceeded) {
+        isSucceeded = fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+    }
+
+    return fclose(file) == 0 && isSucceeded;
+}
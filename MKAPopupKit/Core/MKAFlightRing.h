@@ -0,0 +1,166 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKAFlightRing_h
+#define MKAFlightRing_h
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A fixed-size ring buffer of the presentation events. The recorded inputs of the lifecycle functions can be replayed
+ * through the same functions, and each recorded result tells whether the replay reproduces the field sequence.
+ * Writers are lock-free and do not allocate. The oldest events are overwritten when the buffer is full.
+ */
+
+typedef enum MKAFlightEventType {
+    // Inputs of `MKAPopupStateHandle`. The result is whether the transition is accepted.
+    MKAFlightEventTypePopupShow = 1,
+    MKAFlightEventTypePopupShowFinished,
+    MKAFlightEventTypePopupHide,
+    MKAFlightEventTypePopupHideFinished,
+    MKAFlightEventTypePopupDidAppear,
+    MKAFlightEventTypePopupDidDisappear,
+
+    // Inputs of the toast lifecycle functions. The result is the returned value.
+    /**
+     * The value is the display time.
+     */
+    MKAFlightEventTypeToastShow = 16,
+    MKAFlightEventTypeToastFadeInFinished,
+    /**
+     * The flags are 1 for a manual hide.
+     */
+    MKAFlightEventTypeToastHide,
+    MKAFlightEventTypeToastFadeOutFinished,
+    MKAFlightEventTypeToastSuspend,
+    MKAFlightEventTypeToastResume,
+    /**
+     * The result is the state before it was canceled.
+     */
+    MKAFlightEventTypeToastCancel,
+    MKAFlightEventTypeToastDidAppear,
+    MKAFlightEventTypeToastDidDisappear,
+    /**
+     * The object is the toast and the count is the length of the queue of the stack.
+     */
+    MKAFlightEventTypeToastEnqueue,
+    MKAFlightEventTypeToastDequeue,
+
+    // Inputs of the indicator lifecycle functions. The result is the returned action, the count is the counter after it,
+    // the value is the grace period and the second value is the minimum display time.
+    /**
+     * The flags are 1 when the grace period is used.
+     */
+    MKAFlightEventTypeIndicatorShow = 32,
+    MKAFlightEventTypeIndicatorHide,
+    MKAFlightEventTypeIndicatorHideForcibly,
+    MKAFlightEventTypeIndicatorGracePeriodElapsed,
+    MKAFlightEventTypeIndicatorMinimumDisplayTimeElapsed,
+} MKAFlightEventType;
+
+typedef struct MKAFlightEvent {
+    double time;
+    /**
+     * An identifier of the component, that is unique while it is alive.
+     */
+    uint64_t object;
+    double value;
+    double secondValue;
+    uint32_t count;
+    uint16_t type;
+    uint8_t result;
+    uint8_t flags;
+} MKAFlightEvent;
+
+typedef struct MKAFlightSlot {
+    /**
+     * `2 * index + 1` while the event is written and `2 * index + 2` after it is written.
+     */
+    _Atomic(uint64_t) sequence;
+    MKAFlightEvent event;
+} MKAFlightSlot;
+
+typedef struct MKAFlightRing {
+    MKAFlightSlot *slots;
+    /**
+     * The number of the slots. It is a power of two.
+     */
+    size_t capacity;
+    /**
+     * The index of the next event.
+     */
+    _Atomic(uint64_t) head;
+    atomic_bool isEnabled;
+} MKAFlightRing;
+
+/**
+ * The header of a dump file. The events follow it from the oldest one in the byte order of the recording machine.
+ */
+typedef struct MKAFlightDumpHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t eventSize;
+    uint64_t eventCount;
+} MKAFlightDumpHeader;
+
+extern const char MKAFlightDumpMagic[8];
+extern const uint32_t MKAFlightDumpVersion;
+
+/**
+ * Initializes the ring buffer. Recording is disabled until `MKAFlightRingSetEnabled` is called.
+ *
+ * @param slots A buffer of the slots.
+ * @param capacity The number of the slots. It must be a power of two.
+ */
+void MKAFlightRingInit(MKAFlightRing *ring, MKAFlightSlot *slots, size_t capacity);
+void MKAFlightRingSetEnabled(MKAFlightRing *ring, bool isEnabled);
+/**
+ * Records the event if recording is enabled. It is safe to call on any thread.
+ */
+void MKAFlightRingRecord(MKAFlightRing *ring, const MKAFlightEvent *event);
+/**
+ * Copies the recorded events from the oldest one. The events being written are skipped.
+ *
+ * @return The number of the copied events.
+ */
+size_t MKAFlightRingCopyEvents(MKAFlightRing *ring, MKAFlightEvent *events, size_t capacity);
+/**
+ * Writes the recorded events to a file without allocating a buffer.
+ *
+ * @return true if the file is written.
+ */
+bool MKAFlightRingWriteFile(MKAFlightRing *ring, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKAFlightRing_h */
@@ -0,0 +1,120 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKALayout.h"
+
+static double MKALayoutMax(double a, double b) {
+    return a > b ? a : b;
+}
+
+static double MKALayoutMin(double a, double b) {
+    return a < b ? a : b;
+}
+
+// MARK: - popup
+
+MKAPopupViewLayout MKALayoutPopupView(MKALayoutSize popupSize, MKALayoutSize titleSize) {
+    MKAPopupViewLayout layout;
+
+    layout.titleFrame.origin.x = (popupSize.width - titleSize.width) / 2.0;
+    layout.titleFrame.origin.y = 0;
+    layout.titleFrame.size = titleSize;
+
+    layout.containerFrame.origin.x = 0;
+    layout.containerFrame.origin.y = titleSize.height;
+    layout.containerFrame.size.width = popupSize.width;
+    layout.containerFrame.size.height = MKALayoutMax(popupSize.height - titleSize.height, 0);
+
+    return layout;
+}
+
+MKALayoutSize MKALayoutClampPopupSize(MKALayoutSize requestedSize, MKALayoutSize containerSize, MKALayoutInsets safeArea) {
+    const double width = MKALayoutMax(containerSize.width - safeArea.left - safeArea.right, 0);
+    const double height = MKALayoutMax(containerSize.height - safeArea.top - safeArea.bottom, 0);
+    MKALayoutSize size;
+
+    size.width = MKALayoutMin(requestedSize.width, width);
+    size.height = MKALayoutMin(requestedSize.height, height);
+
+    return size;
+}
+
+MKALayoutPoint MKALayoutPopupCenter(MKALayoutSize containerSize, MKALayoutInsets safeArea) {
+    MKALayoutPoint center;
+
+    center.x = safeArea.left + (containerSize.width - safeArea.left - safeArea.right) / 2.0;
+    center.y = safeArea.top + (containerSize.height - safeArea.top - safeArea.bottom) / 2.0;
+
+    return center;
+}
+
+// MARK: - bottom sheet
+
+MKALayoutRect MKALayoutBottomSheet(MKALayoutSize containerSize, double sheetHeight, MKALayoutInsets safeArea) {
+    MKALayoutRect frame;
+
+    frame.size.width = containerSize.width;
+    frame.size.height = MKALayoutMax(sheetHeight, 0) + safeArea.bottom;
+    frame.origin.x = 0;
+    frame.origin.y = containerSize.height - frame.size.height;
+
+    return frame;
+}
+
+// MARK: - toast
+
+double MKALayoutToastLabelWidth(double toastWidth, double horizontalMargin) {
+    return MKALayoutMax(toastWidth - horizontalMargin * 2.0, 0);
+}
+
+MKALayoutRect MKALayoutToastLabel(MKALayoutSize toastSize, MKALayoutSize labelSize) {
+    MKALayoutRect frame;
+
+    frame.size = labelSize;
+    frame.origin.x = (toastSize.width - labelSize.width) / 2.0;
+    frame.origin.y = (toastSize.height - labelSize.height) / 2.0;
+
+    return frame;
+}
+
+MKALayoutPoint MKALayoutToastCenter(MKALayoutSize containerSize,
+                                    MKALayoutSize toastSize,
+                                    double bottomMargin,
+                                    MKALayoutInsets safeArea) {
+    MKALayoutPoint center;
+
+    center.x = safeArea.left + (containerSize.width - safeArea.left - safeArea.right) / 2.0;
+    center.y = containerSize.height - safeArea.bottom - bottomMargin - toastSize.height / 2.0;
+
+    return center;
+}
+
+void MKALayoutToastStack(const double *heights, size_t count, double spacing, double *offsets) {
+    double offset = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        offsets[i] = offset;
+        offset += heights[i] + spacing;
+    }
+}
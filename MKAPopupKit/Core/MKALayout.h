@@ -0,0 +1,123 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKALayout_h
+#define MKALayout_h
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The layout of popups, bottom sheets and toasts as pure functions.
+ * They do not depend on UIKit and do not allocate. The UIKit classes measure the texts,
+ * pass the sizes and apply the returned frames.
+ */
+
+typedef struct MKALayoutPoint {
+    double x;
+    double y;
+} MKALayoutPoint;
+
+typedef struct MKALayoutSize {
+    double width;
+    double height;
+} MKALayoutSize;
+
+typedef struct MKALayoutRect {
+    MKALayoutPoint origin;
+    MKALayoutSize size;
+} MKALayoutRect;
+
+typedef struct MKALayoutInsets {
+    double top;
+    double left;
+    double bottom;
+    double right;
+} MKALayoutInsets;
+
+typedef struct MKAPopupViewLayout {
+    MKALayoutRect titleFrame;
+    MKALayoutRect containerFrame;
+} MKAPopupViewLayout;
+
+// MARK: - popup
+
+/**
+ * Places the title at the top center of the popup view and the container below it.
+ *
+ * @param titleSize A size of the title. Zero if the popup has no title.
+ */
+MKAPopupViewLayout MKALayoutPopupView(MKALayoutSize popupSize, MKALayoutSize titleSize);
+/**
+ * Returns the requested size of the popup view clamped to the area inside the safe area of the container.
+ */
+MKALayoutSize MKALayoutClampPopupSize(MKALayoutSize requestedSize, MKALayoutSize containerSize, MKALayoutInsets safeArea);
+/**
+ * Returns the center of the area inside the safe area of the container.
+ */
+MKALayoutPoint MKALayoutPopupCenter(MKALayoutSize containerSize, MKALayoutInsets safeArea);
+
+// MARK: - bottom sheet
+
+/**
+ * Returns the frame of the sheet attached to the bottom of the container.
+ * The sheet extends below the bottom safe area, so its content keeps `sheetHeight`.
+ */
+MKALayoutRect MKALayoutBottomSheet(MKALayoutSize containerSize, double sheetHeight, MKALayoutInsets safeArea);
+
+// MARK: - toast
+
+/**
+ * Returns the maximum width of the label in the toast view with given margins on both sides.
+ */
+double MKALayoutToastLabelWidth(double toastWidth, double horizontalMargin);
+/**
+ * Returns the frame of the label centered in the toast view.
+ */
+MKALayoutRect MKALayoutToastLabel(MKALayoutSize toastSize, MKALayoutSize labelSize);
+/**
+ * Returns the center of the toast view placed at the horizontal center above the bottom margin.
+ */
+MKALayoutPoint MKALayoutToastCenter(MKALayoutSize containerSize,
+                                    MKALayoutSize toastSize,
+                                    double bottomMargin,
+                                    MKALayoutInsets safeArea);
+/**
+ * Lays out a stack of toast views from the newest one at the bottom.
+ * Writes the vertical offset of each toast view from the bottom slot to `offsets`.
+ *
+ * @param heights The heights of the toast views from the newest one.
+ * @param count The number of the toast views.
+ * @param offsets An array that has `count` elements at least.
+ */
+void MKALayoutToastStack(const double *heights, size_t count, double spacing, double *offsets);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKALayout_h */
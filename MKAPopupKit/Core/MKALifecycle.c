@@ -0,0 +1,290 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKALifecycle.h"
+
+// MARK: - popup
+
+/**
+ * Returns the state after given event, or -1 if the event is illegal in the state.
+ */
+static int MKAPopupStateNext(MKAPopupState state, MKAPopupEvent event) {
+    switch (event) {
+        case MKAPopupEventShow:
+            return state == MKAPopupStateHidden ? MKAPopupStateShowing : -1;
+        case MKAPopupEventShowFinished:
+            return state == MKAPopupStateShowing ? MKAPopupStateShown : -1;
+        case MKAPopupEventHide:
+            return state == MKAPopupStateShowing || state == MKAPopupStateShown ? MKAPopupStateHiding : -1;
+        case MKAPopupEventHideFinished:
+            return state == MKAPopupStateHiding ? MKAPopupStateHidden : -1;
+        default:
+            return -1;
+    }
+}
+
+bool MKAPopupStateCanHandle(MKAPopupState state, MKAPopupEvent event) {
+    return MKAPopupStateNext(state, event) >= 0;
+}
+
+bool MKAPopupStateHandle(MKAPopupState *state, MKAPopupEvent event) {
+    const int next = MKAPopupStateNext(*state, event);
+
+    if (next < 0) {
+        return false;
+    }
+
+    *state = (MKAPopupState) next;
+    return true;
+}
+
+// MARK: - toast
+
+static bool MKAToastLifecycleIsForever(const MKAToastLifecycle *lifecycle) {
+    return lifecycle->holdTime < 0;
+}
+
+/**
+ * Starts the hold timer if the toast is holding and can be seen.
+ */
+static bool MKAToastLifecycleStartHoldTimer(MKAToastLifecycle *lifecycle, double now, double *delay) {
+    if (lifecycle->state != MKAToastStateHolding || lifecycle->isSuspended || lifecycle->isHoldTimerRunning) {
+        return false;
+    }
+    if (MKAToastLifecycleIsForever(lifecycle) || lifecycle->remainingTime <= 0) {
+        return false;
+    }
+
+    lifecycle->isHoldTimerRunning = true;
+    lifecycle->holdStartTime = now;
+    *delay = lifecycle->remainingTime;
+
+    return true;
+}
+
+void MKAToastLifecycleInit(MKAToastLifecycle *lifecycle, double holdTime) {
+    lifecycle->state = MKAToastStateIdle;
+    lifecycle->holdTime = holdTime;
+    lifecycle->remainingTime = holdTime;
+    lifecycle->holdStartTime = 0;
+    lifecycle->isHoldTimerRunning = false;
+    lifecycle->isSuspended = false;
+}
+
+bool MKAToastLifecycleShow(MKAToastLifecycle *lifecycle) {
+    if (lifecycle->state != MKAToastStateIdle && lifecycle->state != MKAToastStateFinished) {
+        return false;
+    }
+
+    lifecycle->state = MKAToastStateFadingIn;
+    lifecycle->remainingTime = lifecycle->holdTime;
+    lifecycle->isHoldTimerRunning = false;
+
+    return true;
+}
+
+bool MKAToastLifecycleFadeInFinished(MKAToastLifecycle *lifecycle, double now, double *delay) {
+    if (lifecycle->state != MKAToastStateFadingIn) {
+        return false;
+    }
+
+    lifecycle->state = MKAToastStateHolding;
+
+    return MKAToastLifecycleStartHoldTimer(lifecycle, now, delay);
+}
+
+bool MKAToastLifecycleHide(MKAToastLifecycle *lifecycle, bool isManual) {
+    if (isManual) {
+        if (lifecycle->state != MKAToastStateFadingIn && lifecycle->state != MKAToastStateHolding) {
+            return false;
+        }
+    }
+    else if (lifecycle->state != MKAToastStateHolding || !lifecycle->isHoldTimerRunning) {
+        return false;
+    }
+
+    lifecycle->state = MKAToastStateFadingOut;
+    lifecycle->remainingTime = 0;
+    lifecycle->isHoldTimerRunning = false;
+    lifecycle->isSuspended = false;
+
+    return true;
+}
+
+bool MKAToastLifecycleFadeOutFinished(MKAToastLifecycle *lifecycle) {
+    if (lifecycle->state != MKAToastStateFadingOut) {
+        return false;
+    }
+
+    lifecycle->state = MKAToastStateFinished;
+
+    return true;
+}
+
+MKAToastState MKAToastLifecycleCancel(MKAToastLifecycle *lifecycle) {
+    const MKAToastState state = lifecycle->state;
+
+    if (state != MKAToastStateIdle) {
+        lifecycle->state = MKAToastStateFinished;
+    }
+
+    lifecycle->remainingTime = 0;
+    lifecycle->isHoldTimerRunning = false;
+    lifecycle->isSuspended = false;
+
+    return state;
+}
+
+bool MKAToastLifecycleSuspend(MKAToastLifecycle *lifecycle, double now) {
+    if (lifecycle->isSuspended) {
+        return false;
+    }
+
+    lifecycle->isSuspended = true;
+
+    if (!lifecycle->isHoldTimerRunning) {
+        return false;
+    }
+
+    const double remainingTime = lifecycle->remainingTime - (now - lifecycle->holdStartTime);
+    lifecycle->remainingTime = remainingTime > 0 ? remainingTime : 0;
+    lifecycle->isHoldTimerRunning = false;
+
+    return true;
+}
+
+bool MKAToastLifecycleResume(MKAToastLifecycle *lifecycle, double now, double *delay) {
+    if (!lifecycle->isSuspended) {
+        return false;
+    }
+
+    lifecycle->isSuspended = false;
+
+    return MKAToastLifecycleStartHoldTimer(lifecycle, now, delay);
+}
+
+// MARK: - indicator
+
+void MKAIndicatorLifecycleInit(MKAIndicatorLifecycle *lifecycle) {
+    lifecycle->state = MKAIndicatorStateHidden;
+    lifecycle->count = 0;
+    lifecycle->gracePeriod = 0;
+    lifecycle->minimumDisplayTime = 0;
+    lifecycle->presentedTime = 0;
+    lifecycle->skippedShowCount = 0;
+}
+
+MKAIndicatorAction MKAIndicatorLifecycleShow(MKAIndicatorLifecycle *lifecycle, double now, bool usesGracePeriod, double *delay) {
+    if (++lifecycle->count > 1) {
+        return MKAIndicatorActionNone;
+    }
+
+    switch (lifecycle->state) {
+        case MKAIndicatorStateLingering:
+            // Keeps displaying the indicator waiting for the minimum display time.
+            lifecycle->state = MKAIndicatorStatePresented;
+            return MKAIndicatorActionCancelScheduled;
+        case MKAIndicatorStateHidden:
+            if (usesGracePeriod && lifecycle->gracePeriod > 0) {
+                lifecycle->state = MKAIndicatorStatePending;
+                *delay = lifecycle->gracePeriod;
+                return MKAIndicatorActionSchedulePresent;
+            }
+            lifecycle->state = MKAIndicatorStatePresented;
+            lifecycle->presentedTime = now;
+            return MKAIndicatorActionPresent;
+        default:
+            return MKAIndicatorActionNone;
+    }
+}
+
+MKAIndicatorAction MKAIndicatorLifecycleHide(MKAIndicatorLifecycle *lifecycle, double now, double *delay) {
+    if (lifecycle->count == 0 || --lifecycle->count > 0) {
+        return MKAIndicatorActionNone;
+    }
+
+    if (lifecycle->state == MKAIndicatorStatePending) {
+        // Finished within the grace period.
+        lifecycle->state = MKAIndicatorStateHidden;
+        ++lifecycle->skippedShowCount;
+        return MKAIndicatorActionCancelScheduled;
+    }
+
+    if (lifecycle->state != MKAIndicatorStatePresented) {
+        return MKAIndicatorActionNone;
+    }
+
+    const double remainingTime = lifecycle->minimumDisplayTime - (now - lifecycle->presentedTime);
+
+    if (remainingTime > 0) {
+        lifecycle->state = MKAIndicatorStateLingering;
+        *delay = remainingTime;
+        return MKAIndicatorActionScheduleDismiss;
+    }
+
+    lifecycle->state = MKAIndicatorStateHidden;
+    return MKAIndicatorActionDismiss;
+}
+
+MKAIndicatorAction MKAIndicatorLifecycleHideForcibly(MKAIndicatorLifecycle *lifecycle) {
+    const MKAIndicatorState state = lifecycle->state;
+
+    lifecycle->count = 0;
+    lifecycle->state = MKAIndicatorStateHidden;
+
+    switch (state) {
+        case MKAIndicatorStatePending:
+            return MKAIndicatorActionCancelScheduled;
+        case MKAIndicatorStatePresented:
+        case MKAIndicatorStateLingering:
+            return MKAIndicatorActionDismiss;
+        default:
+            return MKAIndicatorActionNone;
+    }
+}
+
+MKAIndicatorAction MKAIndicatorLifecycleGracePeriodElapsed(MKAIndicatorLifecycle *lifecycle, double now) {
+    if (lifecycle->state != MKAIndicatorStatePending) {
+        return MKAIndicatorActionNone;
+    }
+
+    lifecycle->state = MKAIndicatorStatePresented;
+    lifecycle->presentedTime = now;
+
+    return MKAIndicatorActionPresent;
+}
+
+MKAIndicatorAction MKAIndicatorLifecycleMinimumDisplayTimeElapsed(MKAIndicatorLifecycle *lifecycle) {
+    if (lifecycle->state != MKAIndicatorStateLingering) {
+        return MKAIndicatorActionNone;
+    }
+
+    lifecycle->state = MKAIndicatorStateHidden;
+
+    return MKAIndicatorActionDismiss;
+}
+
+bool MKAIndicatorLifecycleIsPresented(const MKAIndicatorLifecycle *lifecycle) {
+    return lifecycle->state == MKAIndicatorStatePresented || lifecycle->state == MKAIndicatorStateLingering;
+}
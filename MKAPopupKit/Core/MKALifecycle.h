@@ -0,0 +1,206 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKALifecycle_h
+#define MKALifecycle_h
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The lifecycles of popups, toasts and indicators as plain state machines.
+ * They do not depend on UIKit nor on the clock. The UIKit classes pass the current time and
+ * perform the actions returned by the functions. Every function runs in constant time and does not allocate.
+ */
+
+// MARK: - popup
+
+typedef enum MKAPopupState {
+    MKAPopupStateHidden = 0,
+    MKAPopupStateShowing,
+    MKAPopupStateShown,
+    MKAPopupStateHiding,
+} MKAPopupState;
+
+typedef enum MKAPopupEvent {
+    MKAPopupEventShow = 0,
+    MKAPopupEventShowFinished,
+    MKAPopupEventHide,
+    MKAPopupEventHideFinished,
+} MKAPopupEvent;
+
+/**
+ * Tells whether given event is legal in the state.
+ */
+bool MKAPopupStateCanHandle(MKAPopupState state, MKAPopupEvent event);
+/**
+ * Applies given event to the state.
+ *
+ * @return true if the transition is legal and the state is changed, otherwise false and the state is kept.
+ */
+bool MKAPopupStateHandle(MKAPopupState *state, MKAPopupEvent event);
+
+// MARK: - toast
+
+typedef enum MKAToastState {
+    MKAToastStateIdle = 0,
+    MKAToastStateFadingIn,
+    MKAToastStateHolding,
+    MKAToastStateFadingOut,
+    MKAToastStateFinished,
+} MKAToastState;
+
+typedef struct MKAToastLifecycle {
+    MKAToastState state;
+    /**
+     * The display time in seconds. A negative value means that the toast is displayed until it is hidden manually.
+     */
+    double holdTime;
+    /**
+     * The rest of the display time.
+     */
+    double remainingTime;
+    /**
+     * The time when the running hold timer was started.
+     */
+    double holdStartTime;
+    bool isHoldTimerRunning;
+    bool isSuspended;
+} MKAToastLifecycle;
+
+void MKAToastLifecycleInit(MKAToastLifecycle *lifecycle, double holdTime);
+/**
+ * Starts fading in. It is legal when the toast is idle or finished.
+ */
+bool MKAToastLifecycleShow(MKAToastLifecycle *lifecycle);
+/**
+ * Starts holding the toast.
+ *
+ * @param delay Set to the time after which the hold timer fires, if it returns true.
+ * @return true if the hold timer must be started.
+ */
+bool MKAToastLifecycleFadeInFinished(MKAToastLifecycle *lifecycle, double now, double *delay);
+/**
+ * Starts fading out when the hold timer fires, or when the toast is hidden manually while it is fading in or holding.
+ *
+ * @return true if the toast must fade out.
+ */
+bool MKAToastLifecycleHide(MKAToastLifecycle *lifecycle, bool isManual);
+bool MKAToastLifecycleFadeOutFinished(MKAToastLifecycle *lifecycle);
+/**
+ * Finishes the toast at once in any state. The pending hold timer and fade must be canceled.
+ *
+ * @return The state before it was canceled.
+ */
+MKAToastState MKAToastLifecycleCancel(MKAToastLifecycle *lifecycle);
+/**
+ * Keeps the rest of the display time while the toast can not be seen.
+ *
+ * @return true if the running hold timer must be stopped.
+ */
+bool MKAToastLifecycleSuspend(MKAToastLifecycle *lifecycle, double now);
+/**
+ * @param delay Set to the rest of the display time, if it returns true.
+ * @return true if the hold timer must be started again.
+ */
+bool MKAToastLifecycleResume(MKAToastLifecycle *lifecycle, double now, double *delay);
+
+// MARK: - indicator
+
+typedef enum MKAIndicatorState {
+    MKAIndicatorStateHidden = 0,
+    /**
+     * Shown but waiting for the grace period. No view is displayed.
+     */
+    MKAIndicatorStatePending,
+    MKAIndicatorStatePresented,
+    /**
+     * Hidden but displayed until the minimum display time elapses.
+     */
+    MKAIndicatorStateLingering,
+} MKAIndicatorState;
+
+typedef enum MKAIndicatorAction {
+    MKAIndicatorActionNone = 0,
+    MKAIndicatorActionPresent,
+    MKAIndicatorActionDismiss,
+    /**
+     * Schedules the end of the grace period after the returned delay.
+     */
+    MKAIndicatorActionSchedulePresent,
+    /**
+     * Schedules the end of the minimum display time after the returned delay.
+     */
+    MKAIndicatorActionScheduleDismiss,
+    MKAIndicatorActionCancelScheduled,
+} MKAIndicatorAction;
+
+typedef struct MKAIndicatorLifecycle {
+    MKAIndicatorState state;
+    /**
+     * The number of show calls that have not been hidden.
+     */
+    unsigned long count;
+    double gracePeriod;
+    double minimumDisplayTime;
+    double presentedTime;
+    /**
+     * The number of shows that finished within the grace period.
+     */
+    unsigned long skippedShowCount;
+} MKAIndicatorLifecycle;
+
+void MKAIndicatorLifecycleInit(MKAIndicatorLifecycle *lifecycle);
+/**
+ * Increments the counter.
+ *
+ * @param usesGracePeriod false to present without waiting for the grace period.
+ * @param delay Set to the grace period when it returns `MKAIndicatorActionSchedulePresent`.
+ */
+MKAIndicatorAction MKAIndicatorLifecycleShow(MKAIndicatorLifecycle *lifecycle, double now, bool usesGracePeriod, double *delay);
+/**
+ * Decrements the counter.
+ *
+ * @param delay Set to the rest of the minimum display time when it returns `MKAIndicatorActionScheduleDismiss`.
+ */
+MKAIndicatorAction MKAIndicatorLifecycleHide(MKAIndicatorLifecycle *lifecycle, double now, double *delay);
+/**
+ * Resets the counter and dismisses the indicator immediately.
+ */
+MKAIndicatorAction MKAIndicatorLifecycleHideForcibly(MKAIndicatorLifecycle *lifecycle);
+MKAIndicatorAction MKAIndicatorLifecycleGracePeriodElapsed(MKAIndicatorLifecycle *lifecycle, double now);
+MKAIndicatorAction MKAIndicatorLifecycleMinimumDisplayTimeElapsed(MKAIndicatorLifecycle *lifecycle);
+/**
+ * Tells whether the indicator view is displayed.
+ */
+bool MKAIndicatorLifecycleIsPresented(const MKAIndicatorLifecycle *lifecycle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKALifecycle_h */
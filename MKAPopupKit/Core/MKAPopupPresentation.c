@@ -0,0 +1,109 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKAPopupPresentation.h"
+
+void MKAPopupPresentationInit(MKAPopupPresentation *presentation,
+                              MKARenderNode node,
+                              MKARenderNode popupNode,
+                              MKAPopupPlacement placement) {
+    presentation->state = MKAPopupStateHidden;
+    presentation->placement = placement;
+    presentation->node = node;
+    presentation->popupNode = popupNode;
+    presentation->popupSize.width = 0;
+    presentation->popupSize.height = 0;
+}
+
+MKALayoutRect MKAPopupPresentationPopupFrame(const MKAPopupPresentation *presentation,
+                                             MKALayoutSize size,
+                                             MKALayoutInsets safeArea) {
+    if (presentation->placement == MKAPopupPlacementBottom) {
+        return MKALayoutBottomSheet(size, presentation->popupSize.height, safeArea);
+    }
+
+    const MKALayoutPoint center = MKALayoutPopupCenter(size, safeArea);
+    MKALayoutRect frame;
+
+    frame.size = presentation->popupSize;
+    frame.origin.x = center.x - frame.size.width / 2.0;
+    frame.origin.y = center.y - frame.size.height / 2.0;
+
+    return frame;
+}
+
+void MKAPopupPresentationLayout(const MKAPopupPresentation *presentation,
+                                const MKARenderBackend *backend,
+                                MKALayoutSize size,
+                                MKALayoutInsets safeArea) {
+    MKARenderSetFrame(backend, presentation->popupNode, MKAPopupPresentationPopupFrame(presentation, size, safeArea));
+}
+
+bool MKAPopupPresentationShow(MKAPopupPresentation *presentation,
+                              const MKARenderBackend *backend,
+                              MKARenderNode parent,
+                              MKALayoutSize parentSize,
+                              MKALayoutInsets safeArea,
+                              double duration) {
+    if (!MKAPopupStateHandle(&presentation->state, MKAPopupEventShow)) {
+        return false;
+    }
+
+    MKALayoutRect frame;
+    frame.origin.x = 0;
+    frame.origin.y = 0;
+    frame.size = parentSize;
+
+    MKARenderInsert(backend, presentation->node, parent);
+    MKARenderSetFrame(backend, presentation->node, frame);
+    MKAPopupPresentationLayout(presentation, backend, parentSize, safeArea);
+    // The background and the popup view are animated together.
+    MKARenderBeginAnimation(backend, presentation->node, duration);
+
+    return true;
+}
+
+bool MKAPopupPresentationShowFinished(MKAPopupPresentation *presentation) {
+    return MKAPopupStateHandle(&presentation->state, MKAPopupEventShowFinished);
+}
+
+bool MKAPopupPresentationHide(MKAPopupPresentation *presentation, const MKARenderBackend *backend, double duration) {
+    if (!MKAPopupStateHandle(&presentation->state, MKAPopupEventHide)) {
+        return false;
+    }
+
+    MKARenderBeginAnimation(backend, presentation->node, duration);
+
+    return true;
+}
+
+bool MKAPopupPresentationHideFinished(MKAPopupPresentation *presentation, const MKARenderBackend *backend) {
+    if (!MKAPopupStateHandle(&presentation->state, MKAPopupEventHideFinished)) {
+        return false;
+    }
+
+    MKARenderRemove(backend, presentation->node);
+
+    return true;
+}
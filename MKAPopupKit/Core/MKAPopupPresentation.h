@@ -0,0 +1,117 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKAPopupPresentation_h
+#define MKAPopupPresentation_h
+
+#include <stdbool.h>
+
+#include "MKALayout.h"
+#include "MKALifecycle.h"
+#include "MKARenderBackend.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The presentation of a popup or a bottom sheet as the sequence of the operations on a render backend.
+ * Showing inserts the background node, sets the frames of the background and the popup view from MKALayout,
+ * and begins one animation. No constraint is activated: the UIKit adapter keeps the background sized to its parent
+ * with the autoresizing mask. Hiding begins one animation and the end of it removes the background node.
+ */
+
+typedef enum MKAPopupPlacement {
+    /**
+     * The popup view is centered in the safe area.
+     */
+    MKAPopupPlacementCenter = 0,
+    /**
+     * The popup view is attached to the bottom with the full width.
+     */
+    MKAPopupPlacementBottom,
+} MKAPopupPlacement;
+
+typedef struct MKAPopupPresentation {
+    MKAPopupState state;
+    MKAPopupPlacement placement;
+    /**
+     * The background node that covers its parent node.
+     */
+    MKARenderNode node;
+    /**
+     * The popup view in the background node.
+     */
+    MKARenderNode popupNode;
+    /**
+     * The size of the popup view. Only the height is used at the bottom.
+     */
+    MKALayoutSize popupSize;
+} MKAPopupPresentation;
+
+void MKAPopupPresentationInit(MKAPopupPresentation *presentation,
+                              MKARenderNode node,
+                              MKARenderNode popupNode,
+                              MKAPopupPlacement placement);
+/**
+ * Returns the frame of the popup view in the background node of given size.
+ */
+MKALayoutRect MKAPopupPresentationPopupFrame(const MKAPopupPresentation *presentation,
+                                             MKALayoutSize size,
+                                             MKALayoutInsets safeArea);
+/**
+ * Sets the frame of the popup view in the background node of given size.
+ */
+void MKAPopupPresentationLayout(const MKAPopupPresentation *presentation,
+                                const MKARenderBackend *backend,
+                                MKALayoutSize size,
+                                MKALayoutInsets safeArea);
+/**
+ * Inserts the background node into the parent node, lays it out and begins the showing animation.
+ *
+ * @return false if the popup can not be shown in its state. Nothing is rendered then.
+ */
+bool MKAPopupPresentationShow(MKAPopupPresentation *presentation,
+                              const MKARenderBackend *backend,
+                              MKARenderNode parent,
+                              MKALayoutSize parentSize,
+                              MKALayoutInsets safeArea,
+                              double duration);
+bool MKAPopupPresentationShowFinished(MKAPopupPresentation *presentation);
+/**
+ * Begins the hiding animation.
+ *
+ * @return false if the popup can not be hidden in its state. Nothing is rendered then.
+ */
+bool MKAPopupPresentationHide(MKAPopupPresentation *presentation, const MKARenderBackend *backend, double duration);
+/**
+ * Removes the background node.
+ */
+bool MKAPopupPresentationHideFinished(MKAPopupPresentation *presentation, const MKARenderBackend *backend);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKAPopupPresentation_h */
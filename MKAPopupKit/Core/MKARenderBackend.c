@@ -0,0 +1,153 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKARenderBackend.h"
+
+#include <string.h>
+
+// MARK: - backend
+
+MKARenderBackend MKARenderBackendNull(void) {
+    MKARenderBackend backend;
+    memset(&backend, 0, sizeof(backend));
+
+    return backend;
+}
+
+void MKARenderInsert(const MKARenderBackend *backend, MKARenderNode node, MKARenderNode parent) {
+    if (backend && backend->insertNode) {
+        backend->insertNode(backend->context, node, parent);
+    }
+}
+
+void MKARenderRemove(const MKARenderBackend *backend, MKARenderNode node) {
+    if (backend && backend->removeNode) {
+        backend->removeNode(backend->context, node);
+    }
+}
+
+void MKARenderPin(const MKARenderBackend *backend, MKARenderNode node, MKARenderNode parent) {
+    if (backend && backend->pinNode) {
+        backend->pinNode(backend->context, node, parent);
+    }
+}
+
+void MKARenderSetFrame(const MKARenderBackend *backend, MKARenderNode node, MKALayoutRect frame) {
+    if (backend && backend->setFrame) {
+        backend->setFrame(backend->context, node, frame);
+    }
+}
+
+void MKARenderBeginAnimation(const MKARenderBackend *backend, MKARenderNode node, double duration) {
+    if (backend && backend->beginAnimation) {
+        backend->beginAnimation(backend->context, node, duration);
+    }
+}
+
+// MARK: - recorder
+
+static void MKARenderRecorderAppend(MKARenderRecorder *recorder, MKARenderEvent event) {
+    if (recorder->events && recorder->eventCount < recorder->capacity) {
+        recorder->events[recorder->eventCount++] = event;
+    }
+}
+
+static MKARenderEvent MKARenderEventMake(MKARenderEventType type, MKARenderNode node, MKARenderNode parent) {
+    MKARenderEvent event;
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.node = node;
+    event.parent = parent;
+
+    return event;
+}
+
+static void MKARenderRecorderInsertNode(void *context, MKARenderNode node, MKARenderNode parent) {
+    MKARenderRecorder *recorder = context;
+    recorder->counts.insertions++;
+    MKARenderRecorderAppend(recorder, MKARenderEventMake(MKARenderEventTypeInsert, node, parent));
+    MKARenderInsert(recorder->next, node, parent);
+}
+
+static void MKARenderRecorderRemoveNode(void *context, MKARenderNode node) {
+    MKARenderRecorder *recorder = context;
+    recorder->counts.removals++;
+    MKARenderRecorderAppend(recorder, MKARenderEventMake(MKARenderEventTypeRemove, node, NULL));
+    MKARenderRemove(recorder->next, node);
+}
+
+static void MKARenderRecorderPinNode(void *context, MKARenderNode node, MKARenderNode parent) {
+    MKARenderRecorder *recorder = context;
+    recorder->counts.constraintActivations++;
+    MKARenderRecorderAppend(recorder, MKARenderEventMake(MKARenderEventTypePin, node, parent));
+    MKARenderPin(recorder->next, node, parent);
+}
+
+static void MKARenderRecorderSetFrame(void *context, MKARenderNode node, MKALayoutRect frame) {
+    MKARenderRecorder *recorder = context;
+    MKARenderEvent event = MKARenderEventMake(MKARenderEventTypeSetFrame, node, NULL);
+    event.frame = frame;
+
+    recorder->counts.frameChanges++;
+    MKARenderRecorderAppend(recorder, event);
+    MKARenderSetFrame(recorder->next, node, frame);
+}
+
+static void MKARenderRecorderBeginAnimation(void *context, MKARenderNode node, double duration) {
+    MKARenderRecorder *recorder = context;
+    MKARenderEvent event = MKARenderEventMake(MKARenderEventTypeBeginAnimation, node, NULL);
+    event.duration = duration;
+
+    recorder->counts.animations++;
+    MKARenderRecorderAppend(recorder, event);
+    MKARenderBeginAnimation(recorder->next, node, duration);
+}
+
+void MKARenderRecorderInit(MKARenderRecorder *recorder,
+                           MKARenderEvent *events,
+                           size_t capacity,
+                           const MKARenderBackend *next) {
+    memset(recorder, 0, sizeof(*recorder));
+    recorder->events = events;
+    recorder->capacity = events ? capacity : 0;
+    recorder->next = next;
+}
+
+void MKARenderRecorderReset(MKARenderRecorder *recorder) {
+    memset(&recorder->counts, 0, sizeof(recorder->counts));
+    recorder->eventCount = 0;
+}
+
+MKARenderBackend MKARenderRecorderBackend(MKARenderRecorder *recorder) {
+    MKARenderBackend backend;
+
+    backend.context = recorder;
+    backend.insertNode = MKARenderRecorderInsertNode;
+    backend.removeNode = MKARenderRecorderRemoveNode;
+    backend.pinNode = MKARenderRecorderPinNode;
+    backend.setFrame = MKARenderRecorderSetFrame;
+    backend.beginAnimation = MKARenderRecorderBeginAnimation;
+
+    return backend;
+}
@@ -0,0 +1,158 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKARenderBackend_h
+#define MKARenderBackend_h
+
+#include <stddef.h>
+
+#include "MKALayout.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The operations that the components perform on their views, as a table of functions.
+ * The UIKit adapters send every insertion, removal, constraint activation, frame change and animation start
+ * through the current backend, so the same presentation logic can run against UIKit, do nothing, or be recorded.
+ */
+
+/**
+ * An opaque reference to a view. The UIKit backend receives bridged UIView pointers.
+ */
+typedef const void *MKARenderNode;
+
+typedef struct MKARenderBackend {
+    void *context;
+    /**
+     * Adds the node to the top of the parent node.
+     */
+    void (*insertNode)(void *context, MKARenderNode node, MKARenderNode parent);
+    /**
+     * Removes the node from its parent node.
+     */
+    void (*removeNode)(void *context, MKARenderNode node);
+    /**
+     * Activates the constraints pinning the four edges of the node to the parent node.
+     */
+    void (*pinNode)(void *context, MKARenderNode node, MKARenderNode parent);
+    /**
+     * Sets the size and the center of the node. The transform of the node is kept.
+     */
+    void (*setFrame)(void *context, MKARenderNode node, MKALayoutRect frame);
+    /**
+     * Called before the component starts an animation of the node. The animation itself is run by the component.
+     * The node is NULL when the animation moves several nodes at once.
+     */
+    void (*beginAnimation)(void *context, MKARenderNode node, double duration);
+} MKARenderBackend;
+
+typedef enum MKARenderEventType {
+    MKARenderEventTypeInsert,
+    MKARenderEventTypeRemove,
+    MKARenderEventTypePin,
+    MKARenderEventTypeSetFrame,
+    MKARenderEventTypeBeginAnimation,
+} MKARenderEventType;
+
+typedef struct MKARenderEvent {
+    MKARenderEventType type;
+    MKARenderNode node;
+    /**
+     * The parent node of an insertion or a pin. Otherwise NULL.
+     */
+    MKARenderNode parent;
+    /**
+     * The frame of a frame change. Otherwise zero.
+     */
+    MKALayoutRect frame;
+    /**
+     * The duration of an animation. Otherwise zero.
+     */
+    double duration;
+} MKARenderEvent;
+
+typedef struct MKARenderCounts {
+    size_t insertions;
+    size_t removals;
+    size_t constraintActivations;
+    size_t frameChanges;
+    size_t animations;
+} MKARenderCounts;
+
+typedef struct MKARenderRecorder {
+    MKARenderCounts counts;
+    /**
+     * A buffer of the recorded events given by the caller. Events after the buffer is full are only counted.
+     */
+    MKARenderEvent *events;
+    size_t capacity;
+    size_t eventCount;
+    /**
+     * A backend to forward the operations to after recording. NULL not to forward.
+     */
+    const MKARenderBackend *next;
+} MKARenderRecorder;
+
+// MARK: - backend
+
+/**
+ * Returns the backend that does nothing. It is used to measure the cost of the presentation logic alone.
+ */
+MKARenderBackend MKARenderBackendNull(void);
+
+void MKARenderInsert(const MKARenderBackend *backend, MKARenderNode node, MKARenderNode parent);
+void MKARenderRemove(const MKARenderBackend *backend, MKARenderNode node);
+void MKARenderPin(const MKARenderBackend *backend, MKARenderNode node, MKARenderNode parent);
+void MKARenderSetFrame(const MKARenderBackend *backend, MKARenderNode node, MKALayoutRect frame);
+void MKARenderBeginAnimation(const MKARenderBackend *backend, MKARenderNode node, double duration);
+
+// MARK: - recorder
+
+/**
+ * Initializes the recorder.
+ *
+ * @param events A buffer to store the events. NULL to count the operations only.
+ * @param capacity The number of the elements of the buffer.
+ * @param next A backend to forward the operations to. NULL not to forward.
+ */
+void MKARenderRecorderInit(MKARenderRecorder *recorder,
+                           MKARenderEvent *events,
+                           size_t capacity,
+                           const MKARenderBackend *next);
+/**
+ * Clears the counts and the recorded events.
+ */
+void MKARenderRecorderReset(MKARenderRecorder *recorder);
+/**
+ * Returns the backend that records the operations into the recorder. The recorder must outlive the backend.
+ */
+MKARenderBackend MKARenderRecorderBackend(MKARenderRecorder *recorder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKARenderBackend_h */
@@ -0,0 +1,229 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKATimerWheel.h"
+
+#include <math.h>
+
+// MARK: - list
+
+static void MKATimerWheelListInit(MKATimerWheelEntry *head) {
+    head->prev = head;
+    head->next = head;
+}
+
+static void MKATimerWheelListAppend(MKATimerWheelEntry *head, MKATimerWheelEntry *entry) {
+    entry->prev = head->prev;
+    entry->next = head;
+    head->prev->next = entry;
+    head->prev = entry;
+}
+
+/**
+ * Inserts the entry after the entries whose deadlines are not later than its one, so the list stays ordered by the
+ * deadlines and the entries of the same tick keep their order. It takes constant time when the entries come in order.
+ */
+static void MKATimerWheelListInsertByDeadline(MKATimerWheelEntry *head, MKATimerWheelEntry *entry) {
+    MKATimerWheelEntry *previous = head->prev;
+
+    while (previous != head && previous->deadlineTick > entry->deadlineTick) {
+        previous = previous->prev;
+    }
+
+    MKATimerWheelListAppend(previous->next, entry);
+}
+
+static void MKATimerWheelListRemove(MKATimerWheelEntry *entry) {
+    entry->prev->next = entry->next;
+    entry->next->prev = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+}
+
+static void MKATimerWheelRelease(MKATimerWheel *wheel, MKATimerWheelEntry *entry) {
+    entry->isArmed = false;
+    entry->callback = NULL;
+    entry->info = NULL;
+    entry->generation++;
+    entry->next = wheel->freeEntries;
+    wheel->freeEntries = entry;
+    wheel->count--;
+}
+
+// MARK: - timer wheel
+
+void MKATimerWheelInit(MKATimerWheel *wheel,
+                       MKATimerWheelEntry *slots,
+                       size_t slotCount,
+                       MKATimerWheelEntry *entries,
+                       size_t capacity,
+                       double tickInterval,
+                       double startTime) {
+    wheel->tickInterval = tickInterval;
+    wheel->startTime = startTime;
+    wheel->currentTick = 0;
+    wheel->slots = slots;
+    wheel->slotCount = slotCount;
+    wheel->entries = entries;
+    wheel->capacity = capacity;
+    wheel->freeEntries = NULL;
+    wheel->count = 0;
+
+    for (size_t i = 0; i < slotCount; i++) {
+        MKATimerWheelListInit(&slots[i]);
+    }
+
+    // Pushes in reverse order, so the entries are used from the first one.
+    for (size_t i = capacity; i > 0; i--) {
+        MKATimerWheelEntry *entry = &entries[i - 1];
+        entry->prev = NULL;
+        entry->isArmed = false;
+        entry->generation = 0;
+        entry->next = wheel->freeEntries;
+        wheel->freeEntries = entry;
+    }
+}
+
+MKAClockTimer MKATimerWheelArm(MKATimerWheel *wheel, double now, double delay, MKAClockCallback callback, void *info) {
+    MKATimerWheelEntry *entry = wheel->freeEntries;
+
+    if (!entry || !callback) {
+        return 0;
+    }
+
+    wheel->freeEntries = entry->next;
+    wheel->count++;
+
+    const double ticks = ceil((now + (delay > 0 ? delay : 0) - wheel->startTime) / wheel->tickInterval);
+    const uint64_t deadlineTick = ticks > 0 ? (uint64_t) ticks : 0;
+
+    entry->deadlineTick = deadlineTick > wheel->currentTick ? deadlineTick : wheel->currentTick + 1;
+    entry->callback = callback;
+    entry->info = info;
+    entry->isArmed = true;
+    MKATimerWheelListAppend(&wheel->slots[entry->deadlineTick & (wheel->slotCount - 1)], entry);
+
+    const uint64_t index = (uint64_t) (entry - wheel->entries);
+
+    return ((MKAClockTimer) entry->generation << 32) | (index + 1);
+}
+
+bool MKATimerWheelCancel(MKATimerWheel *wheel, MKAClockTimer timer) {
+    const uint64_t index = (timer & 0xffffffff) - 1;
+
+    if (timer == 0 || index >= wheel->capacity) {
+        return false;
+    }
+
+    MKATimerWheelEntry *entry = &wheel->entries[index];
+
+    if (!entry->isArmed || entry->generation != (uint32_t) (timer >> 32)) {
+        return false;
+    }
+
+    MKATimerWheelListRemove(entry);
+    MKATimerWheelRelease(wheel, entry);
+
+    return true;
+}
+
+size_t MKATimerWheelAdvance(MKATimerWheel *wheel, double now) {
+    const double ticks = floor((now - wheel->startTime) / wheel->tickInterval);
+    const uint64_t targetTick = ticks > 0 ? (uint64_t) ticks : 0;
+    MKATimerWheelEntry expired;
+    size_t visitedSlotCount = 0;
+    size_t fired = 0;
+
+    MKATimerWheelListInit(&expired);
+
+    // Visits each slot at most once however far the time jumps.
+    while (wheel->currentTick < targetTick && visitedSlotCount < wheel->slotCount) {
+        wheel->currentTick++;
+        visitedSlotCount++;
+
+        MKATimerWheelEntry *head = &wheel->slots[wheel->currentTick & (wheel->slotCount - 1)];
+        MKATimerWheelEntry *entry = head->next;
+
+        while (entry != head) {
+            MKATimerWheelEntry *next = entry->next;
+
+            if (entry->deadlineTick <= targetTick) {
+                // A jump beyond a rotation visits a slot after later ones, so the entries are ordered by their deadlines.
+                MKATimerWheelListRemove(entry);
+                MKATimerWheelListInsertByDeadline(&expired, entry);
+            }
+
+            entry = next;
+        }
+    }
+
+    if (wheel->currentTick < targetTick) {
+        wheel->currentTick = targetTick;
+    }
+
+    // The expired entries stay linked until they fire, so the callbacks can cancel them.
+    while (expired.next != &expired) {
+        MKATimerWheelEntry *entry = expired.next;
+        const MKAClockCallback callback = entry->callback;
+        void *info = entry->info;
+
+        MKATimerWheelListRemove(entry);
+        MKATimerWheelRelease(wheel, entry);
+        callback(info);
+        fired++;
+    }
+
+    return fired;
+}
+
+bool MKATimerWheelNextDeadline(const MKATimerWheel *wheel, double *deadline) {
+    uint64_t nextTick = UINT64_MAX;
+    bool isFound = false;
+
+    // Visits the slots in the order of their ticks, so the first entry due in the current round is the earliest one.
+    // An entry of a later round is a candidate only if no slot has an entry of the current round.
+    for (size_t i = 1; i <= wheel->slotCount && !isFound && wheel->count > 0; i++) {
+        const uint64_t tick = wheel->currentTick + i;
+        const MKATimerWheelEntry *head = &wheel->slots[tick & (wheel->slotCount - 1)];
+
+        for (const MKATimerWheelEntry *entry = head->next; entry != head; entry = entry->next) {
+            if (entry->deadlineTick < nextTick) {
+                nextTick = entry->deadlineTick;
+            }
+
+            if (entry->deadlineTick == tick) {
+                isFound = true;
+                break;
+            }
+        }
+    }
+
+    if (nextTick == UINT64_MAX) {
+        return false;
+    }
+
+    *deadline = wheel->startTime + (double) nextTick * wheel->tickInterval;
+
+    return true;
+}
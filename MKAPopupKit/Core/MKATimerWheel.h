@@ -0,0 +1,118 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKATimerWheel_h
+#define MKATimerWheel_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "MKAClock.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A hashed timer wheel. A timer is linked into the slot of its deadline tick, so arming and canceling take constant time
+ * and one periodic tick fires all the timers of the components. It does not allocate: the slots and the timer entries
+ * are buffers given by the caller.
+ */
+
+typedef struct MKATimerWheelEntry {
+    struct MKATimerWheelEntry *prev;
+    struct MKATimerWheelEntry *next;
+    uint64_t deadlineTick;
+    MKAClockCallback callback;
+    void *info;
+    /**
+     * Incremented every time the entry is reused, so a stale timer can not cancel a new one.
+     */
+    uint32_t generation;
+    bool isArmed;
+} MKATimerWheelEntry;
+
+typedef struct MKATimerWheel {
+    double tickInterval;
+    double startTime;
+    uint64_t currentTick;
+    /**
+     * The list heads of the slots. The number of the slots is a power of two.
+     */
+    MKATimerWheelEntry *slots;
+    size_t slotCount;
+    MKATimerWheelEntry *entries;
+    size_t capacity;
+    MKATimerWheelEntry *freeEntries;
+    size_t count;
+} MKATimerWheel;
+
+/**
+ * Initializes the timer wheel.
+ *
+ * @param slots A buffer of the slots. `slotCount` must be a power of two.
+ * @param entries A buffer of the timer entries. Timers beyond `capacity` are not armed.
+ * @param tickInterval The resolution of the timers in seconds.
+ * @param startTime The current time.
+ */
+void MKATimerWheelInit(MKATimerWheel *wheel,
+                       MKATimerWheelEntry *slots,
+                       size_t slotCount,
+                       MKATimerWheelEntry *entries,
+                       size_t capacity,
+                       double tickInterval,
+                       double startTime);
+/**
+ * Arms a timer that calls the callback once on the first tick after `now + delay`.
+ *
+ * @return A timer, or zero if all entries are in use.
+ */
+MKAClockTimer MKATimerWheelArm(MKATimerWheel *wheel, double now, double delay, MKAClockCallback callback, void *info);
+/**
+ * Cancels the armed timer.
+ *
+ * @return true if the timer was armed, otherwise false.
+ */
+bool MKATimerWheelCancel(MKATimerWheel *wheel, MKAClockTimer timer);
+/**
+ * Moves the wheel to given time and fires the expired timers.
+ * Timers armed or canceled by the callbacks are handled on this call or a later one.
+ *
+ * @return The number of the fired timers.
+ */
+size_t MKATimerWheelAdvance(MKATimerWheel *wheel, double now);
+/**
+ * Finds the time of the earliest tick that fires an armed timer, so the caller can sleep until then.
+ *
+ * @param deadline The time the wheel has to be advanced to.
+ * @return true if a timer is armed, otherwise false.
+ */
+bool MKATimerWheelNextDeadline(const MKATimerWheel *wheel, double *deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MKATimerWheel_h */
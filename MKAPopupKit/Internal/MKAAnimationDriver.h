@@ -0,0 +1,79 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A custom animation updated by the shared animation driver on every frame.
+ */
+@protocol MKAAnimationTimeline <NSObject>
+/**
+ * Updates the animation for the frame.
+ *
+ * @param timestamp The time of the frame in the media time.
+ * @return NO if the animation has finished. Then it is removed from the driver.
+ */
+- (BOOL)stepAtTime:(CFTimeInterval)timestamp;
+
+@optional
+/**
+ * Returns the frame rate the animation needs. Zero means the maximum frame rate of the display.
+ */
+- (NSInteger)preferredFramesPerSecond;
+
+@end
+
+/**
+ * Runs all custom animations of popups, toasts and indicators on one display link.
+ * The display link runs only while an animation is added, and updates all of them in one transaction per frame.
+ * The animations are not retained. All methods must be called on the main thread.
+ */
+@interface MKAAnimationDriver : NSObject
+/**
+ * The number of the running animations.
+ */
+@property (nonatomic, readonly) NSUInteger activeCount;
+
++ (instancetype)sharedDriver;
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ * Starts updating given animation from the next frame. Adding the running animation does nothing.
+ */
+- (void)addTimeline:(id <MKAAnimationTimeline>)timeline;
+/**
+ * Stops updating given animation.
+ */
+- (void)removeTimeline:(id <MKAAnimationTimeline>)timeline;
+/**
+ * Applies the changed frame rate of the running animations.
+ */
+- (void)setNeedsUpdateFrameRate;
+
+@end
+
+NS_ASSUME_NONNULL_END
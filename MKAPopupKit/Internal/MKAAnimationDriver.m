@@ -0,0 +1,150 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAAnimationDriver.h"
+
+@interface MKAAnimationDriver ()
+
+@property (nonatomic) NSHashTable<id <MKAAnimationTimeline>> *timelines;
+@property (nonatomic, nullable) CADisplayLink *displayLink;
+
+@end
+
+@implementation MKAAnimationDriver
+
++ (instancetype)sharedDriver {
+    static MKAAnimationDriver *driver = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        driver = [[MKAAnimationDriver alloc] initPrivately];
+    });
+
+    return driver;
+}
+
+- (instancetype)initPrivately {
+    if (self = [super init]) {
+        _timelines = [NSHashTable weakObjectsHashTable];
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (NSUInteger)activeCount {
+    return self.timelines.allObjects.count;
+}
+
+#pragma mark - public method
+
+- (void)addTimeline:(id <MKAAnimationTimeline>)timeline {
+    if ([self.timelines containsObject:timeline]) {
+        return;
+    }
+
+    [self.timelines addObject:timeline];
+
+    if (!self.displayLink) {
+        self.displayLink = [CADisplayLink displayLinkWithTarget:self selector:@selector(step:)];
+        [self.displayLink addToRunLoop:[NSRunLoop mainRunLoop] forMode:NSRunLoopCommonModes];
+    }
+
+    [self setNeedsUpdateFrameRate];
+    self.displayLink.paused = NO;
+}
+
+- (void)removeTimeline:(id <MKAAnimationTimeline>)timeline {
+    if (![self.timelines containsObject:timeline]) {
+        return;
+    }
+
+    [self.timelines removeObject:timeline];
+    [self setNeedsUpdateFrameRate];
+}
+
+- (void)setNeedsUpdateFrameRate {
+    if (!self.displayLink) {
+        return;
+    }
+
+    // Runs at the highest rate any animation needs.
+    NSInteger framesPerSecond = 0;
+
+    for (id <MKAAnimationTimeline> timeline in self.timelines) {
+        const NSInteger preferred = [timeline respondsToSelector:@selector(preferredFramesPerSecond)] ?
+            timeline.preferredFramesPerSecond : 0;
+
+        if (preferred <= 0) {
+            framesPerSecond = 0;
+            break;
+        }
+
+        framesPerSecond = MAX(framesPerSecond, preferred);
+    }
+
+    if (@available(iOS 15.0, *)) {
+        const float rate = (float) framesPerSecond;
+        self.displayLink.preferredFrameRateRange = framesPerSecond > 0 ? CAFrameRateRangeMake(rate, rate, rate) : CAFrameRateRangeDefault;
+    }
+    else {
+        self.displayLink.preferredFramesPerSecond = framesPerSecond;
+    }
+}
+
+#pragma mark - private method
+
+- (void)step:(CADisplayLink *)displayLink {
+    NSArray<id <MKAAnimationTimeline>> *timelines = self.timelines.allObjects;
+
+    if (timelines.count == 0) {
+        // Stops the display link, so nothing runs while idle.
+        displayLink.paused = YES;
+        return;
+    }
+
+    NSMutableArray<id <MKAAnimationTimeline>> *finishedTimelines = nil;
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+
+    for (id <MKAAnimationTimeline> timeline in timelines) {
+        if (![timeline stepAtTime:displayLink.timestamp]) {
+            finishedTimelines = finishedTimelines ?: [NSMutableArray array];
+            [finishedTimelines addObject:timeline];
+        }
+    }
+
+    [CATransaction commit];
+
+    for (id <MKAAnimationTimeline> timeline in finishedTimelines) {
+        [self removeTimeline:timeline];
+    }
+
+    if (self.timelines.allObjects.count == 0) {
+        displayLink.paused = YES;
+    }
+}
+
+@end
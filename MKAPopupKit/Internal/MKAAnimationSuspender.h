@@ -0,0 +1,85 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * An object whose animations are suspended while its view can not be seen.
+ */
+@protocol MKAAnimationSuspendable <NSObject>
+/**
+ * Returns the view displaying the animations, or nil when nothing is displayed.
+ */
+- (nullable UIView *)suspendableView;
+/**
+ * Pauses or resumes the animations. It is called on the main thread only when the state changes.
+ */
+- (void)setAnimationSuspended:(BOOL)suspended;
+
+@end
+
+/**
+ * Suspends the animations of registered objects while the app is in the background,
+ * their views are not in a window or they are fully covered by an opaque popup.
+ * All methods must be called on the main thread.
+ */
+@interface MKAAnimationSuspender : NSObject
+/**
+ * Tells whether the app is in the background.
+ */
+@property (nonatomic, readonly) BOOL isInBackground;
+
++ (instancetype)sharedSuspender;
+
+/**
+ * Starts watching given object and suspends it immediately if its view can not be seen.
+ */
+- (void)addSuspendable:(id <MKAAnimationSuspendable>)suspendable;
+/**
+ * Stops watching given object. It does not resume the object.
+ */
+- (void)removeSuspendable:(id <MKAAnimationSuspendable>)suspendable;
+/**
+ * Adds the view covering the views below it when its background is opaque.
+ */
+- (void)addOccluder:(UIView *)view;
+- (void)removeOccluder:(UIView *)view;
+/**
+ * Updates the states of all objects once at the next run loop turn.
+ */
+- (void)setNeedsUpdate;
+
+@end
+
+/**
+ * An invisible view that requests the update of the suspender when it moves to or from a window.
+ * It is added to a view whose window can not be observed otherwise.
+ */
+@interface MKAWindowObserverView : UIView
+
+@end
+
+NS_ASSUME_NONNULL_END
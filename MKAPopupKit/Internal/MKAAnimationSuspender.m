@@ -0,0 +1,215 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAAnimationSuspender.h"
+
+/**
+ * Returns YES if `upper` is drawn above `lower` in the same view hierarchy.
+ */
+static BOOL MKAViewIsAboveView(UIView *upper, UIView *lower) {
+    NSMutableArray<UIView *> *lowerAncestors = [NSMutableArray array];
+
+    for (UIView *view = lower; view; view = view.superview) {
+        [lowerAncestors addObject:view];
+    }
+
+    UIView *upperChild = nil;
+
+    for (UIView *view = upper; view; view = view.superview) {
+        const NSUInteger index = [lowerAncestors indexOfObjectIdenticalTo:view];
+
+        if (index == NSNotFound) {
+            upperChild = view;
+            continue;
+        }
+
+        if (!upperChild) {
+            // `upper` contains `lower`.
+            return NO;
+        }
+        if (index == 0) {
+            // `lower` contains `upper`.
+            return YES;
+        }
+
+        NSArray<UIView *> *subviews = view.subviews;
+        return [subviews indexOfObjectIdenticalTo:upperChild] > [subviews indexOfObjectIdenticalTo:lowerAncestors[index - 1]];
+    }
+
+    return NO;
+}
+
+@interface MKAAnimationSuspender ()
+
+@property (nonatomic) BOOL isInBackground;
+@property (nonatomic) NSHashTable<id <MKAAnimationSuspendable>> *suspendables;
+@property (nonatomic) NSHashTable<UIView *> *occluders;
+/**
+ * The objects suspended by the suspender.
+ */
+@property (nonatomic) NSHashTable<id <MKAAnimationSuspendable>> *suspendedObjects;
+@property (nonatomic) BOOL isUpdateScheduled;
+
+@end
+
+@implementation MKAAnimationSuspender
+
++ (instancetype)sharedSuspender {
+    static MKAAnimationSuspender *suspender = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        suspender = [MKAAnimationSuspender new];
+    });
+
+    return suspender;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _suspendables = [NSHashTable weakObjectsHashTable];
+        _occluders = [NSHashTable weakObjectsHashTable];
+        _suspendedObjects = [NSHashTable weakObjectsHashTable];
+
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [center addObserver:self
+                   selector:@selector(applicationDidEnterBackground:)
+                       name:UIApplicationDidEnterBackgroundNotification
+                     object:nil];
+        [center addObserver:self
+                   selector:@selector(applicationWillEnterForeground:)
+                       name:UIApplicationWillEnterForegroundNotification
+                     object:nil];
+    }
+
+    return self;
+}
+
+#pragma mark - public method
+
+- (void)addSuspendable:(id <MKAAnimationSuspendable>)suspendable {
+    [self.suspendables addObject:suspendable];
+    [self updateSuspendable:suspendable];
+}
+
+- (void)removeSuspendable:(id <MKAAnimationSuspendable>)suspendable {
+    [self.suspendables removeObject:suspendable];
+    [self.suspendedObjects removeObject:suspendable];
+}
+
+- (void)addOccluder:(UIView *)view {
+    [self.occluders addObject:view];
+    [self setNeedsUpdate];
+}
+
+- (void)removeOccluder:(UIView *)view {
+    [self.occluders removeObject:view];
+    [self setNeedsUpdate];
+}
+
+- (void)setNeedsUpdate {
+    if (self.isUpdateScheduled || self.suspendables.count == 0) {
+        return;
+    }
+
+    self.isUpdateScheduled = YES;
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+        self.isUpdateScheduled = NO;
+
+        for (id <MKAAnimationSuspendable> suspendable in self.suspendables.allObjects) {
+            [self updateSuspendable:suspendable];
+        }
+    });
+}
+
+#pragma mark - private method
+
+- (void)applicationDidEnterBackground:(NSNotification *)notification {
+    self.isInBackground = YES;
+    [self setNeedsUpdate];
+}
+
+- (void)applicationWillEnterForeground:(NSNotification *)notification {
+    self.isInBackground = NO;
+    [self setNeedsUpdate];
+}
+
+- (void)updateSuspendable:(id <MKAAnimationSuspendable>)suspendable {
+    UIView *view = [suspendable suspendableView];
+    const BOOL shouldSuspend = view && (self.isInBackground || !view.window || [self isViewOccluded:view]);
+    const BOOL isSuspended = [self.suspendedObjects containsObject:suspendable];
+
+    if (shouldSuspend == isSuspended) {
+        return;
+    }
+
+    if (shouldSuspend) {
+        [self.suspendedObjects addObject:suspendable];
+    }
+    else {
+        [self.suspendedObjects removeObject:suspendable];
+    }
+
+    [suspendable setAnimationSuspended:shouldSuspend];
+}
+
+- (BOOL)isViewOccluded:(UIView *)view {
+    for (UIView *occluder in self.occluders) {
+        if (occluder.window != view.window || occluder.isHidden || occluder.alpha < 1.f) {
+            continue;
+        }
+        if (CGColorGetAlpha(occluder.backgroundColor.CGColor) < 1.f) {
+            continue;
+        }
+
+        const CGRect frame = [view convertRect:view.bounds toView:occluder];
+
+        if (CGRectContainsRect(occluder.bounds, frame) && MKAViewIsAboveView(occluder, view)) {
+            return YES;
+        }
+    }
+
+    return NO;
+}
+
+@end
+
+@implementation MKAWindowObserverView
+
+- (instancetype)init {
+    if (self = [super initWithFrame:CGRectZero]) {
+        self.hidden = YES;
+        self.userInteractionEnabled = NO;
+    }
+
+    return self;
+}
+
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+
+    [[MKAAnimationSuspender sharedSuspender] setNeedsUpdate];
+}
+
+@end
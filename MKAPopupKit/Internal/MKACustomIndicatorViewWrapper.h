@@ -34,6 +34,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic) float repeatCount;
 
 - (void)setImage:(UIImage *)image;
+- (void)setImageNamed:(NSString *)name;
 
 @end
 
@@ -28,6 +28,8 @@
 
 @property (nonatomic) UIView *containerView;
 @property (nonatomic) UIImageView *imageView;
+@property (nonatomic, nullable) UIImage *image;
+@property (nonatomic, copy, nullable) NSString *imageName;
 
 @end
 
@@ -68,9 +70,34 @@
     [self.imageView.layer removeAnimationForKey:MKAIndicatorRotationAnimationKey];
 }
 
+- (NSArray<UIImage *> *)sourceImages {
+    return self.image ? @[self.image] : @[];
+}
+
+- (NSArray<NSString *> *)sourceImageNames {
+    return self.image ? @[self.imageName ?: @""] : @[];
+}
+
+- (void)setPreparedImages:(nullable NSArray<UIImage *> *)images {
+    self.imageView.image = images.firstObject ?: self.image;
+}
+
 #pragma mark - public method
 
+- (void)setImageNamed:(NSString *)name {
+    UIImage *image = [UIImage imageNamed:name];
+
+    if (!image) {
+        return;
+    }
+
+    [self setImage:image];
+    self.imageName = name;
+}
+
 - (void)setImage:(UIImage *)image {
+    _image = image;
+    self.imageName = nil;
     self.imageView.image = image;
     self.containerView.bounds = (CGRect) { CGPointZero, image.size };
 }
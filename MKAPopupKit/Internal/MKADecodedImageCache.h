@@ -0,0 +1,67 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A default limit of the disk cache in bytes.
+ */
+UIKIT_EXTERN const NSUInteger MKADecodedImageCacheDefaultLimit;
+
+/**
+ * A disk cache of decoded bitmaps. A cached bitmap is memory-mapped when it is read,
+ * so it is displayed without decoding and copying.
+ * The cache is disabled by default. All methods are safe to call on any thread.
+ */
+@interface MKADecodedImageCache : NSObject
+/**
+ * Tells whether the cache is used.
+ */
+@property (atomic, getter=isEnabled) BOOL enabled;
+/**
+ * The maximum total size in bytes of the cached files. Oldest files are removed when it is exceeded.
+ */
+@property (atomic) NSUInteger limit;
+
++ (instancetype)sharedCache;
+
+/**
+ * Returns the cached bitmap backed by the memory-mapped file, or nil when it is not cached.
+ */
+- (nullable UIImage *)imageForName:(NSString *)name size:(CGSize)size scale:(CGFloat)scale;
+/**
+ * Returns the cached bitmap if it exists. Otherwise decodes given image at given size and scale and stores it.
+ * When the cache is disabled, only decodes the image.
+ */
+- (nullable UIImage *)decodedImage:(UIImage *)image name:(nullable NSString *)name size:(CGSize)size scale:(CGFloat)scale;
+/**
+ * Removes all cached files.
+ */
+- (void)removeAllImages;
+
+@end
+
+NS_ASSUME_NONNULL_END
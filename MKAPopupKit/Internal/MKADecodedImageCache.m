@@ -0,0 +1,318 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKADecodedImageCache.h"
+
+#import <fcntl.h>
+#import <sys/mman.h>
+#import <sys/stat.h>
+#import <sys/time.h>
+#import <unistd.h>
+
+#import "MKAPopupKitHelper.h"
+
+const NSUInteger MKADecodedImageCacheDefaultLimit = 50 * 1024 * 1024;
+
+/**
+ * "MKAC" in little endian.
+ */
+static const uint32_t kFileMagic = 0x43414B4D;
+/**
+ * Increment it when the file format is changed. Files of other versions are removed when they are read.
+ */
+static const uint32_t kFileVersion = 1;
+/**
+ * The bitmap follows the header at this offset. Rows are aligned to 64 bytes for Core Animation.
+ */
+static const size_t kHeaderSize = 64;
+static const size_t kRowAlignment = 64;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t bytesPerRow;
+    uint32_t bitmapInfo;
+    float scale;
+} MKADecodedImageFileHeader;
+
+static void MKAUnmapBitmap(void *info, const void *data, size_t size) {
+    munmap((uint8_t *) data - kHeaderSize, size + kHeaderSize);
+}
+
+@interface MKADecodedImageCache ()
+
+@property (nonatomic, copy) NSString *directoryPath;
+@property (nonatomic) dispatch_queue_t pruneQueue;
+
+@end
+
+@implementation MKADecodedImageCache
+
++ (instancetype)sharedCache {
+    static MKADecodedImageCache *cache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [MKADecodedImageCache new];
+    });
+
+    return cache;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        NSString *cachesPath = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES).firstObject;
+        _directoryPath = [cachesPath stringByAppendingPathComponent:@"jp.hituzi.MKAPopupKit.DecodedImageCache"];
+        _pruneQueue = dispatch_queue_create("jp.hituzi.MKAPopupKit.DecodedImageCache.PruneQueue", DISPATCH_QUEUE_SERIAL);
+        _enabled = NO;
+        _limit = MKADecodedImageCacheDefaultLimit;
+    }
+
+    return self;
+}
+
+#pragma mark - public method
+
+- (nullable UIImage *)imageForName:(NSString *)name size:(CGSize)size scale:(CGFloat)scale {
+    if (!self.isEnabled) {
+        return nil;
+    }
+
+    NSString *path = [self pathForName:name size:size scale:scale];
+    const int fd = open(path.fileSystemRepresentation, O_RDONLY);
+
+    if (fd < 0) {
+        return nil;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) kHeaderSize) {
+        close(fd);
+        return nil;
+    }
+
+    const size_t length = (size_t) st.st_size;
+    void *mapping = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return nil;
+    }
+
+    MKADecodedImageFileHeader header;
+    memcpy(&header, mapping, sizeof(header));
+    const size_t bitmapSize = (size_t) header.bytesPerRow * header.height;
+
+    if (header.magic != kFileMagic || header.version != kFileVersion || length != kHeaderSize + bitmapSize) {
+        // Broken or old file.
+        munmap(mapping, length);
+        unlink(path.fileSystemRepresentation);
+        return nil;
+    }
+
+    // The bitmap refers to the mapping directly. It is unmapped when the image is released.
+    CGDataProviderRef provider = CGDataProviderCreateWithData(NULL,
+                                                              (uint8_t *) mapping + kHeaderSize,
+                                                              bitmapSize,
+                                                              MKAUnmapBitmap);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGImageRef imageRef = CGImageCreate(header.width,
+                                        header.height,
+                                        8,
+                                        32,
+                                        header.bytesPerRow,
+                                        colorSpace,
+                                        header.bitmapInfo,
+                                        provider,
+                                        NULL,
+                                        false,
+                                        kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+
+    if (!imageRef) {
+        return nil;
+    }
+
+    // Marks the file as recently used for pruning.
+    utimes(path.fileSystemRepresentation, NULL);
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:header.scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+
+    return image;
+}
+
+- (nullable UIImage *)decodedImage:(UIImage *)image name:(nullable NSString *)name size:(CGSize)size scale:(CGFloat)scale {
+    if (!self.isEnabled || name.length == 0) {
+        return [MKAPopupKitHelper decodedImage:image size:size scale:scale];
+    }
+
+    UIImage *cachedImage = [self imageForName:name size:size scale:scale];
+
+    if (cachedImage) {
+        return cachedImage;
+    }
+
+    const size_t width = (size_t) round(size.width * scale);
+    const size_t height = (size_t) round(size.height * scale);
+
+    if (width == 0 || height == 0) {
+        return image;
+    }
+
+    const size_t bytesPerRow = (width * 4 + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+    const uint32_t bitmapInfo = kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host;
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL, width, height, 8, bytesPerRow, colorSpace, bitmapInfo);
+    CGColorSpaceRelease(colorSpace);
+
+    if (!context) {
+        return [MKAPopupKitHelper decodedImage:image size:size scale:scale];
+    }
+
+    // Draws in UIKit coordinates so that the orientation of the image is applied.
+    CGContextTranslateCTM(context, 0, height);
+    CGContextScaleCTM(context, scale, -scale);
+    UIGraphicsPushContext(context);
+    [image drawInRect:CGRectMake(0, 0, size.width, size.height)];
+    UIGraphicsPopContext();
+
+    [self writeBitmap:CGBitmapContextGetData(context)
+                width:width
+               height:height
+          bytesPerRow:bytesPerRow
+           bitmapInfo:bitmapInfo
+                scale:scale
+               toPath:[self pathForName:name size:size scale:scale]];
+
+    CGImageRef imageRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    if (!imageRef) {
+        return image;
+    }
+
+    UIImage *decodedImage = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+
+    return decodedImage;
+}
+
+- (void)removeAllImages {
+    dispatch_sync(self.pruneQueue, ^{
+        [[NSFileManager defaultManager] removeItemAtPath:self.directoryPath error:nil];
+    });
+}
+
+#pragma mark - private method
+
+- (NSString *)pathForName:(NSString *)name size:(CGSize)size scale:(CGFloat)scale {
+    NSString *escapedName = [name stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet alphanumericCharacterSet]];
+    NSString *fileName = [NSString stringWithFormat:@"%@_%gx%g@%gx.bitmap", escapedName, size.width, size.height, scale];
+
+    return [self.directoryPath stringByAppendingPathComponent:fileName];
+}
+
+- (void)writeBitmap:(const void *)bitmap
+              width:(size_t)width
+             height:(size_t)height
+        bytesPerRow:(size_t)bytesPerRow
+         bitmapInfo:(uint32_t)bitmapInfo
+              scale:(CGFloat)scale
+             toPath:(NSString *)path {
+    if (!bitmap) {
+        return;
+    }
+
+    MKADecodedImageFileHeader header = {
+        .magic = kFileMagic,
+        .version = kFileVersion,
+        .width = (uint32_t) width,
+        .height = (uint32_t) height,
+        .bytesPerRow = (uint32_t) bytesPerRow,
+        .bitmapInfo = bitmapInfo,
+        .scale = (float) scale,
+    };
+    NSMutableData *data = [NSMutableData dataWithLength:kHeaderSize];
+    memcpy(data.mutableBytes, &header, sizeof(header));
+    [data appendBytes:bitmap length:bytesPerRow * height];
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:self.directoryPath
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:nil];
+    [data writeToFile:path atomically:YES];
+
+    dispatch_async(self.pruneQueue, ^{
+        [self prune];
+    });
+}
+
+/**
+ * Removes least recently used files until the total size is within the limit.
+ */
+- (void)prune {
+    NSURL *directoryURL = [NSURL fileURLWithPath:self.directoryPath isDirectory:YES];
+    NSArray<NSURLResourceKey> *keys = @[NSURLContentModificationDateKey, NSURLTotalFileAllocatedSizeKey];
+    NSArray<NSURL *> *urls = [[NSFileManager defaultManager] contentsOfDirectoryAtURL:directoryURL
+                                                           includingPropertiesForKeys:keys
+                                                                              options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                                error:nil];
+    NSMutableArray<NSDictionary<NSURLResourceKey, id> *> *files = [NSMutableArray arrayWithCapacity:urls.count];
+    NSUInteger totalSize = 0;
+
+    for (NSURL *url in urls) {
+        NSDictionary<NSURLResourceKey, id> *values = [url resourceValuesForKeys:keys error:nil];
+
+        if (values) {
+            NSMutableDictionary<NSURLResourceKey, id> *file = [values mutableCopy];
+            file[NSURLPathKey] = url.path;
+            [files addObject:file];
+            totalSize += [values[NSURLTotalFileAllocatedSizeKey] unsignedIntegerValue];
+        }
+    }
+
+    if (totalSize <= self.limit) {
+        return;
+    }
+
+    [files sortUsingComparator:^NSComparisonResult(NSDictionary *file1, NSDictionary *file2) {
+        return [file1[NSURLContentModificationDateKey] compare:file2[NSURLContentModificationDateKey]];
+    }];
+
+    for (NSDictionary<NSURLResourceKey, id> *file in files) {
+        if (totalSize <= self.limit) {
+            break;
+        }
+
+        // A mapped file remains readable after it is removed.
+        if ([[NSFileManager defaultManager] removeItemAtPath:file[NSURLPathKey] error:nil]) {
+            totalSize -= [file[NSURLTotalFileAllocatedSizeKey] unsignedIntegerValue];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,53 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "MKAFlightRing.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Records the event into the shared flight recorder with the current time of the scheduler.
+ * It returns immediately while the recorder is disabled.
+ */
+void MKAFlightRecordEvent(const MKAFlightEvent *event);
+
+static inline uint64_t MKAFlightObject(id object) {
+    return (uint64_t) (uintptr_t) (__bridge void *) object;
+}
+
+/**
+ * Records the event that has no value.
+ */
+static inline void MKAFlightRecord(MKAFlightEventType type, id object, uint8_t result, uint32_t count) {
+    MKAFlightRecordEvent(&(MKAFlightEvent) {
+        .object = MKAFlightObject(object),
+        .count = count,
+        .type = (uint16_t) type,
+        .result = result,
+    });
+}
+
+NS_ASSUME_NONNULL_END
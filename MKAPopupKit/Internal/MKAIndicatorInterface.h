@@ -30,12 +30,41 @@ UIKIT_EXTERN NSString *const MKAIndicatorRotationAnimationKey;
 UIKIT_EXTERN const double MKAIndicatorDefaultAnimationDuration;
 UIKIT_EXTERN const float MKAIndicatorDefaultRepeatCount;
 
+/**
+ * Returns the interval of frames to be displayed so that the frame rate does not exceed `framesPerSecond`.
+ * If `framesPerSecond` is 0, all frames are displayed.
+ */
+UIKIT_EXTERN NSInteger MKAIndicatorFrameStep(NSInteger frameCount, double duration, NSInteger framesPerSecond);
+
 @protocol MKAIndicatorInterface <NSObject>
 
 - (UIView *)view;
 - (void)startAnimating;
 - (void)stopAnimating;
 
+@optional
+/**
+ * Returns the images displayed by the indicator. They are prepared for the display in the background.
+ */
+- (NSArray<UIImage *> *)sourceImages;
+/**
+ * Returns the names of the source images in the same order. It is used as the key of the disk cache.
+ * An empty string means that the image has no name.
+ */
+- (NSArray<NSString *> *)sourceImageNames;
+/**
+ * Sets the images decoded at the display size. They are used instead of the source images when they are set.
+ */
+- (void)setPreparedImages:(nullable NSArray<UIImage *> *)images;
+/**
+ * Pauses the work on the main thread for the animation. The animations of the layers are paused by the caller.
+ */
+- (void)pauseAnimating;
+/**
+ * Resumes the animation paused by `pauseAnimating` from where it was paused.
+ */
+- (void)resumeAnimating;
+
 @end
 
 NS_ASSUME_NONNULL_END
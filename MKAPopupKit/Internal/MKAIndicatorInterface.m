@@ -30,3 +30,13 @@ const double MKAIndicatorDefaultAnimationDuration = 1.0;
 
 // Make it a very large value to keep turning indefinitely.
 const float MKAIndicatorDefaultRepeatCount = INT_MAX;
+
+NSInteger MKAIndicatorFrameStep(NSInteger frameCount, double duration, NSInteger framesPerSecond) {
+    if (framesPerSecond <= 0 || frameCount <= 0 || duration <= 0) {
+        return 1;
+    }
+
+    const double frameRate = frameCount / duration;
+
+    return frameRate > framesPerSecond ? (NSInteger) ceil(frameRate / framesPerSecond) : 1;
+}
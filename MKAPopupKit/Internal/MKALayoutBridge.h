@@ -0,0 +1,53 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "MKALayout.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+static inline MKALayoutSize MKALayoutSizeFromCGSize(CGSize size) {
+    return (MKALayoutSize) { size.width, size.height };
+}
+
+static inline MKALayoutInsets MKALayoutInsetsFromUIEdgeInsets(UIEdgeInsets insets) {
+    return (MKALayoutInsets) { insets.top, insets.left, insets.bottom, insets.right };
+}
+
+static inline CGPoint CGPointFromMKALayoutPoint(MKALayoutPoint point) {
+    return CGPointMake(point.x, point.y);
+}
+
+static inline CGSize CGSizeFromMKALayoutSize(MKALayoutSize size) {
+    return CGSizeMake(size.width, size.height);
+}
+
+static inline CGRect CGRectFromMKALayoutRect(MKALayoutRect rect) {
+    return CGRectMake(rect.origin.x, rect.origin.y, rect.size.width, rect.size.height);
+}
+
+static const MKALayoutInsets MKALayoutInsetsZero = { 0, 0, 0, 0 };
+
+NS_ASSUME_NONNULL_END
@@ -30,6 +30,30 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (nullable UIWindow *)keyWindow;
 + (UIView *)rootView;
+/**
+ * Returns the key window of given scene, or of the foreground active scene if the scene is nil. The result is cached.
+ */
++ (nullable UIWindow *)keyWindowInScene:(nullable UIWindowScene *)scene;
+/**
+ * Returns the view where popups, toasts and indicators are added in given scene.
+ */
++ (UIView *)rootViewInScene:(nullable UIWindowScene *)scene;
+/**
+ * Returns the image decompressed into a bitmap. It is safe to call on any thread.
+ */
++ (nullable UIImage *)decodedImage:(nullable UIImage *)image;
+/**
+ * Returns the image redrawn into a bitmap of given size and scale. It is safe to call on any thread.
+ */
++ (nullable UIImage *)decodedImage:(nullable UIImage *)image size:(CGSize)size scale:(CGFloat)scale;
+/**
+ * Stops the local time of given layer, so all animations of the layer and its sublayers are frozen.
+ */
++ (void)pauseLayer:(CALayer *)layer;
+/**
+ * Restarts the local time of given layer paused by `pauseLayer:` from where it was stopped.
+ */
++ (void)resumeLayer:(CALayer *)layer;
 
 @end
 
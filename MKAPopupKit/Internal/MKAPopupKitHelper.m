@@ -24,19 +24,101 @@
 
 #import "MKAPopupKitHelper.h"
 
+#import "MKAWindowResolver.h"
+
 @implementation MKAPopupKitHelper
 
 + (nullable UIWindow *)keyWindow {
-    for (UIWindow *window in [UIApplication sharedApplication].windows) {
-        if (window.isKeyWindow) {
-            return window;
-        }
-    }
-    return nil;
+    return [self keyWindowInScene:nil];
 }
 
 + (UIView *)rootView {
-    return self.keyWindow.subviews.lastObject;
+    return [self rootViewInScene:nil];
+}
+
++ (nullable UIWindow *)keyWindowInScene:(nullable UIWindowScene *)scene {
+    return [[MKAWindowResolver sharedResolver] keyWindowInScene:scene];
+}
+
++ (UIView *)rootViewInScene:(nullable UIWindowScene *)scene {
+    return [self keyWindowInScene:scene].subviews.lastObject;
+}
+
++ (nullable UIImage *)decodedImage:(nullable UIImage *)image {
+    CGImageRef imageRef = image.CGImage;
+
+    if (!imageRef) {
+        return image;
+    }
+
+    const size_t width = CGImageGetWidth(imageRef);
+    const size_t height = CGImageGetHeight(imageRef);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(NULL,
+                                                 width,
+                                                 height,
+                                                 8,
+                                                 0,
+                                                 colorSpace,
+                                                 kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Host);
+    CGColorSpaceRelease(colorSpace);
+
+    if (!context) {
+        return image;
+    }
+
+    // Drawing into the bitmap context forces the decompression.
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), imageRef);
+    CGImageRef decodedRef = CGBitmapContextCreateImage(context);
+    CGContextRelease(context);
+
+    if (!decodedRef) {
+        return image;
+    }
+
+    UIImage *decoded = [UIImage imageWithCGImage:decodedRef scale:image.scale orientation:image.imageOrientation];
+    CGImageRelease(decodedRef);
+
+    return decoded;
+}
+
++ (nullable UIImage *)decodedImage:(nullable UIImage *)image size:(CGSize)size scale:(CGFloat)scale {
+    if (!image || size.width <= 0 || size.height <= 0 || scale <= 0) {
+        return image;
+    }
+
+    UIGraphicsImageRendererFormat *format = [UIGraphicsImageRendererFormat preferredFormat];
+    format.scale = scale;
+    format.opaque = NO;
+    format.preferredRange = UIGraphicsImageRendererFormatRangeStandard;
+
+    UIGraphicsImageRenderer *renderer = [[UIGraphicsImageRenderer alloc] initWithSize:size format:format];
+
+    return [renderer imageWithActions:^(UIGraphicsImageRendererContext *context) {
+        [image drawInRect:CGRectMake(0, 0, size.width, size.height)];
+    }];
+}
+
++ (void)pauseLayer:(CALayer *)layer {
+    if (layer.speed == 0) {
+        return;
+    }
+
+    const CFTimeInterval pausedTime = [layer convertTime:CACurrentMediaTime() fromLayer:nil];
+    layer.speed = 0;
+    layer.timeOffset = pausedTime;
+}
+
++ (void)resumeLayer:(CALayer *)layer {
+    if (layer.speed != 0) {
+        return;
+    }
+
+    const CFTimeInterval pausedTime = layer.timeOffset;
+    layer.speed = 1.f;
+    layer.timeOffset = 0;
+    layer.beginTime = 0;
+    layer.beginTime = [layer convertTime:CACurrentMediaTime() fromLayer:nil] - pausedTime;
 }
 
 @end
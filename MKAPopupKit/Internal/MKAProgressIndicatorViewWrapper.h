@@ -0,0 +1,55 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "MKAIndicator.h"
+#import "MKAIndicatorInterface.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A determinate indicator drawn as a ring or a bar.
+ * The progress can be set on any thread. Only the latest value is applied on the main thread at most once per display frame.
+ */
+@interface MKAProgressIndicatorViewWrapper : NSObject <MKAIndicatorInterface>
+
+@property (nonatomic) MKAIndicatorProgressStyle style;
+@property (nonatomic) UIColor *strokeColor;
+@property (nonatomic, nullable) UIColor *trackColor;
+@property (nonatomic) CGFloat lineWidth;
+@property (nonatomic) BOOL showsLabel;
+
+/**
+ * Returns the latest progress between 0 and 1. It is safe to call on any thread.
+ */
+- (float)progress;
+/**
+ * Stores the progress clamped between 0 and 1. It is safe to call on any thread.
+ */
+- (void)setProgress:(float)progress;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,265 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAProgressIndicatorViewWrapper.h"
+
+#import <stdatomic.h>
+
+#import "MKAAnimationDriver.h"
+
+static NSString *const kProgressAnimationKey = @"jp.hituzi.MKAIndicator.ProgressAnimationKey";
+static const CFTimeInterval kProgressAnimationDuration = .2;
+
+/**
+ * A view that fits the paths of its shape layers and the label to its bounds.
+ */
+@interface MKAProgressView : UIView
+
+@property (nonatomic) MKAIndicatorProgressStyle style;
+@property (nonatomic) CAShapeLayer *trackLayer;
+@property (nonatomic) CAShapeLayer *progressLayer;
+@property (nonatomic) UILabel *label;
+
+@end
+
+@implementation MKAProgressView
+
+- (instancetype)initWithFrame:(CGRect)frame {
+    if (self = [super initWithFrame:frame]) {
+        _trackLayer = [self makeShapeLayer];
+        _progressLayer = [self makeShapeLayer];
+        _progressLayer.strokeEnd = 0;
+        [self.layer addSublayer:_trackLayer];
+        [self.layer addSublayer:_progressLayer];
+
+        _label = [UILabel new];
+        _label.textAlignment = NSTextAlignmentCenter;
+        _label.font = [UIFont monospacedDigitSystemFontOfSize:12.f weight:UIFontWeightMedium];
+        _label.textColor = UIColor.secondaryLabelColor;
+        _label.hidden = YES;
+        [self addSubview:_label];
+    }
+
+    return self;
+}
+
+- (void)layoutSubviews {
+    [super layoutSubviews];
+
+    const CGFloat lineWidth = self.progressLayer.lineWidth;
+    const CGRect bounds = self.bounds;
+    UIBezierPath *path;
+
+    if (self.style == MKAIndicatorProgressStyleBar) {
+        // Places the bar at the bottom below the label, or at the middle without the label.
+        const CGFloat y = self.label.isHidden ? CGRectGetMidY(bounds) : CGRectGetMaxY(bounds) - lineWidth / 2.f;
+        path = [UIBezierPath bezierPath];
+        [path moveToPoint:CGPointMake(lineWidth / 2.f, y)];
+        [path addLineToPoint:CGPointMake(CGRectGetMaxX(bounds) - lineWidth / 2.f, y)];
+        self.label.frame = CGRectMake(0, 0, bounds.size.width, MAX(bounds.size.height - lineWidth * 2.f, 0));
+    }
+    else {
+        // Starts from the top and goes clockwise.
+        const CGFloat radius = MAX(MIN(bounds.size.width, bounds.size.height) / 2.f - lineWidth / 2.f, 0);
+        path = [UIBezierPath bezierPathWithArcCenter:CGPointMake(CGRectGetMidX(bounds), CGRectGetMidY(bounds))
+                                              radius:radius
+                                          startAngle:-M_PI_2
+                                            endAngle:M_PI_2 * 3.0
+                                           clockwise:YES];
+        self.label.frame = bounds;
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    for (CAShapeLayer *layer in @[self.trackLayer, self.progressLayer]) {
+        layer.frame = bounds;
+        layer.path = path.CGPath;
+    }
+    [CATransaction commit];
+}
+
+- (CAShapeLayer *)makeShapeLayer {
+    CAShapeLayer *layer = [CAShapeLayer layer];
+    layer.fillColor = nil;
+    layer.lineCap = kCALineCapRound;
+    // Draws the path at the resolution of the screen.
+    layer.contentsScale = UIScreen.mainScreen.scale;
+
+    return layer;
+}
+
+@end
+
+@interface MKAProgressIndicatorViewWrapper () <MKAAnimationTimeline>
+
+@property (nonatomic) MKAProgressView *progressView;
+/**
+ * Tells whether the progress is applied to the view.
+ */
+@property (nonatomic) BOOL isAnimating;
+/**
+ * The percentage displayed in the label. It is compared to avoid updating the same text.
+ */
+@property (nonatomic) NSInteger displayedPercentage;
+
+@end
+
+@implementation MKAProgressIndicatorViewWrapper {
+    _Atomic(float) _progress;
+    /**
+     * Tells whether a stored progress has not been applied yet.
+     */
+    atomic_bool _isDirty;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _progressView = [[MKAProgressView alloc] initWithFrame:CGRectZero];
+        _displayedPercentage = -1;
+        atomic_init(&_progress, 0.f);
+        atomic_init(&_isDirty, false);
+        self.style = MKAIndicatorProgressStyleRing;
+        self.strokeColor = UIColor.systemBlueColor;
+        self.trackColor = [UIColor.systemGrayColor colorWithAlphaComponent:.3f];
+        self.lineWidth = 4.f;
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (void)setStyle:(MKAIndicatorProgressStyle)style {
+    _style = style;
+    self.progressView.style = style;
+    self.progressView.bounds = style == MKAIndicatorProgressStyleBar ? CGRectMake(0, 0, 160.f, 24.f) : CGRectMake(0, 0, 48.f, 48.f);
+    [self.progressView setNeedsLayout];
+}
+
+- (void)setStrokeColor:(UIColor *)strokeColor {
+    _strokeColor = strokeColor;
+    self.progressView.progressLayer.strokeColor = strokeColor.CGColor;
+}
+
+- (void)setTrackColor:(nullable UIColor *)trackColor {
+    _trackColor = trackColor;
+    self.progressView.trackLayer.strokeColor = trackColor.CGColor;
+}
+
+- (void)setLineWidth:(CGFloat)lineWidth {
+    _lineWidth = lineWidth;
+    self.progressView.trackLayer.lineWidth = lineWidth;
+    self.progressView.progressLayer.lineWidth = lineWidth;
+    [self.progressView setNeedsLayout];
+}
+
+- (void)setShowsLabel:(BOOL)showsLabel {
+    _showsLabel = showsLabel;
+    self.progressView.label.hidden = !showsLabel;
+    [self.progressView setNeedsLayout];
+}
+
+#pragma mark - MKAIndicatorInterface
+
+- (UIView *)view {
+    return self.progressView;
+}
+
+- (void)startAnimating {
+    // Shows the latest progress without animation.
+    atomic_store(&_isDirty, false);
+    [self applyProgress:atomic_load(&_progress) animated:NO];
+    self.isAnimating = YES;
+}
+
+- (void)stopAnimating {
+    self.isAnimating = NO;
+    [[MKAAnimationDriver sharedDriver] removeTimeline:self];
+    [self.progressView.progressLayer removeAnimationForKey:kProgressAnimationKey];
+}
+
+#pragma mark - public method
+
+- (float)progress {
+    return atomic_load(&_progress);
+}
+
+- (void)setProgress:(float)progress {
+    atomic_store(&_progress, MIN(MAX(progress, 0.f), 1.f));
+
+    // Only the first change after the last frame wakes the display link up.
+    if (atomic_exchange(&_isDirty, true)) {
+        return;
+    }
+
+    __weak typeof(self) weakSelf = self;
+
+    // The progress is applied on the next frame of the animation driver, only while there is a new progress.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        typeof(self) strongSelf = weakSelf;
+
+        if (strongSelf.isAnimating) {
+            [[MKAAnimationDriver sharedDriver] addTimeline:strongSelf];
+        }
+    });
+}
+
+#pragma mark - private method
+
+- (void)applyProgress:(float)progress animated:(BOOL)animated {
+    CAShapeLayer *layer = self.progressView.progressLayer;
+
+    if (animated && layer.strokeEnd != progress) {
+        // Animates from the displayed value, so the stroke never jumps back when values come quickly.
+        CABasicAnimation *animation = [CABasicAnimation animationWithKeyPath:@"strokeEnd"];
+        animation.fromValue = @(((CAShapeLayer *) layer.presentationLayer ?: layer).strokeEnd);
+        animation.toValue = @(progress);
+        animation.duration = kProgressAnimationDuration;
+        animation.timingFunction = [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseOut];
+        [layer addAnimation:animation forKey:kProgressAnimationKey];
+    }
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    layer.strokeEnd = progress;
+    [CATransaction commit];
+
+    const NSInteger percentage = (NSInteger) lroundf(progress * 100.f);
+
+    if (self.showsLabel && percentage != self.displayedPercentage) {
+        self.displayedPercentage = percentage;
+        self.progressView.label.text = [NSString stringWithFormat:@"%ld%%", (long) percentage];
+    }
+}
+
+#pragma mark - MKAAnimationTimeline
+
+- (BOOL)stepAtTime:(CFTimeInterval)timestamp {
+    atomic_store(&_isDirty, false);
+    [self applyProgress:atomic_load(&_progress) animated:YES];
+
+    return NO;
+}
+
+@end
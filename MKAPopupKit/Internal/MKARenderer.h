@@ -0,0 +1,63 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "MKALayoutBridge.h"
+#import "MKARenderBackend.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Returns the backend that applies the operations to UIKit views.
+ */
+const MKARenderBackend *MKARendererUIKitBackend(void);
+/**
+ * Returns the backend which popups, toasts and indicators render through. It is the UIKit backend by default.
+ */
+const MKARenderBackend *MKARendererCurrentBackend(void);
+/**
+ * Replaces the current backend with a copy of given backend, or restores the UIKit backend if it is NULL.
+ * Call it on the main thread.
+ */
+void MKARendererSetBackend(const MKARenderBackend *_Nullable backend);
+
+static inline void MKARendererInsertView(UIView *view, UIView *parent) {
+    MKARenderInsert(MKARendererCurrentBackend(), (__bridge MKARenderNode) view, (__bridge MKARenderNode) parent);
+}
+
+static inline void MKARendererRemoveView(UIView *view) {
+    MKARenderRemove(MKARendererCurrentBackend(), (__bridge MKARenderNode) view);
+}
+
+static inline void MKARendererSetFrame(UIView *view, CGRect frame) {
+    MKALayoutRect rect = { { frame.origin.x, frame.origin.y }, MKALayoutSizeFromCGSize(frame.size) };
+    MKARenderSetFrame(MKARendererCurrentBackend(), (__bridge MKARenderNode) view, rect);
+}
+
+static inline void MKARendererBeginAnimation(UIView *_Nullable view, NSTimeInterval duration) {
+    MKARenderBeginAnimation(MKARendererCurrentBackend(), (__bridge MKARenderNode) view, duration);
+}
+
+NS_ASSUME_NONNULL_END
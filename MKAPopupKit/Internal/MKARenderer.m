@@ -0,0 +1,81 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKARenderer.h"
+
+static void MKARendererUIKitInsertNode(void *context, MKARenderNode node, MKARenderNode parent) {
+    [(__bridge UIView *) parent addSubview:(__bridge UIView *) node];
+}
+
+static void MKARendererUIKitRemoveNode(void *context, MKARenderNode node) {
+    [(__bridge UIView *) node removeFromSuperview];
+}
+
+static void MKARendererUIKitPinNode(void *context, MKARenderNode node, MKARenderNode parent) {
+    UIView *view = (__bridge UIView *) node;
+    UIView *parentView = (__bridge UIView *) parent;
+
+    [NSLayoutConstraint activateConstraints:@[
+        [view.topAnchor constraintEqualToAnchor:parentView.topAnchor],
+        [view.leftAnchor constraintEqualToAnchor:parentView.leftAnchor],
+        [view.bottomAnchor constraintEqualToAnchor:parentView.bottomAnchor],
+        [view.rightAnchor constraintEqualToAnchor:parentView.rightAnchor],
+    ]];
+}
+
+static void MKARendererUIKitSetFrame(void *context, MKARenderNode node, MKALayoutRect frame) {
+    UIView *view = (__bridge UIView *) node;
+
+    // Sets the bounds and the center instead of the frame, which is undefined while the view is transformed.
+    view.bounds = (CGRect) { view.bounds.origin, CGSizeFromMKALayoutSize(frame.size) };
+    view.center = CGPointMake(frame.origin.x + frame.size.width / 2.0, frame.origin.y + frame.size.height / 2.0);
+}
+
+static MKARenderBackend _UIKitBackend = {
+    NULL,
+    MKARendererUIKitInsertNode,
+    MKARendererUIKitRemoveNode,
+    MKARendererUIKitPinNode,
+    MKARendererUIKitSetFrame,
+    NULL,   // Animations are run by the components themselves.
+};
+
+static MKARenderBackend _currentBackend;
+static BOOL _hasCustomBackend = NO;
+
+const MKARenderBackend *MKARendererUIKitBackend(void) {
+    return &_UIKitBackend;
+}
+
+const MKARenderBackend *MKARendererCurrentBackend(void) {
+    return _hasCustomBackend ? &_currentBackend : &_UIKitBackend;
+}
+
+void MKARendererSetBackend(const MKARenderBackend *_Nullable backend) {
+    _hasCustomBackend = backend != NULL;
+
+    if (backend) {
+        _currentBackend = *backend;
+    }
+}
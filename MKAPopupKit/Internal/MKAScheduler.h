@@ -0,0 +1,62 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "MKAClock.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Returns the clock that reads the media time and fires the timers on the main queue.
+ * All timers share one timer wheel driven by one dispatch source, which is suspended while no timer is armed.
+ */
+const MKAClock *MKASchedulerSystemClock(void);
+/**
+ * Returns the clock which popups, toasts and indicators read the time from and schedule their works on.
+ * It is the system clock by default.
+ */
+const MKAClock *MKASchedulerCurrentClock(void);
+/**
+ * Replaces the current clock with a copy of given clock, or restores the system clock if it is NULL.
+ * Call it on the main thread before scheduling any work.
+ */
+void MKASchedulerSetClock(const MKAClock *_Nullable clock);
+/**
+ * Returns the current time of the current clock.
+ */
+NSTimeInterval MKASchedulerNow(void);
+/**
+ * Executes given work once after the delay on the current clock. Call it on the main thread.
+ * The scheduler keeps the work only until it is executed or canceled, so capture the target weakly.
+ *
+ * @return A token to cancel the work, or zero if the work could not be scheduled.
+ */
+MKAClockTimer MKASchedulerSchedule(NSTimeInterval delay, dispatch_block_t work);
+/**
+ * Cancels the work not executed yet. Does nothing for zero, an executed or a canceled token.
+ */
+void MKASchedulerCancel(MKAClockTimer token);
+
+NS_ASSUME_NONNULL_END
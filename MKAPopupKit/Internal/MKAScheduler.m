@@ -0,0 +1,229 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAScheduler.h"
+
+#import "MKATimerWheel.h"
+
+@interface MKAScheduledWork : NSObject
+
+@property (nonatomic, copy) dispatch_block_t work;
+@property (nonatomic) MKAClockTimer timer;
+
+@end
+
+@implementation MKAScheduledWork
+@end
+
+/**
+ * The resolution of the system clock. A timer fires on the first tick after its deadline.
+ */
+static const double kTickInterval = 1.0 / 60.0;
+/**
+ * A bit of the timers scheduled by dispatch_after when all entries of the wheel are in use.
+ */
+static const MKAClockTimer kOverflowTimerBit = 1ULL << 63;
+
+static MKATimerWheelEntry _wheelSlots[256];
+static MKATimerWheelEntry _wheelEntries[1024];
+static MKATimerWheel _wheel;
+static dispatch_source_t _tickSource = nil;
+static BOOL _isTicking = NO;
+static BOOL _isAdvancing = NO;
+/**
+ * The time the tick source is set to fire at, or a negative value if it is not set.
+ */
+static double _armedDeadline = -1;
+
+static double MKASchedulerSystemNow(void *context) {
+    return CACurrentMediaTime();
+}
+
+/**
+ * Sets the tick source to fire once at the deadline of the earliest armed timer, and suspends it while no timer is armed.
+ */
+static void MKASchedulerSystemRearm(void) {
+    double deadline;
+
+    if (!MKATimerWheelNextDeadline(&_wheel, &deadline)) {
+        _armedDeadline = -1;
+
+        if (_isTicking) {
+            _isTicking = NO;
+            dispatch_suspend(_tickSource);
+        }
+
+        return;
+    }
+
+    if (_isTicking && deadline == _armedDeadline) {
+        return;
+    }
+
+    const double delay = deadline - CACurrentMediaTime();
+
+    _armedDeadline = deadline;
+    dispatch_source_set_timer(_tickSource,
+                              dispatch_time(DISPATCH_TIME_NOW, delay > 0 ? (int64_t) (delay * NSEC_PER_SEC) : 0),
+                              DISPATCH_TIME_FOREVER,
+                              (uint64_t) (kTickInterval * NSEC_PER_SEC / 10));
+
+    if (!_isTicking) {
+        _isTicking = YES;
+        dispatch_resume(_tickSource);
+    }
+}
+
+/**
+ * Advances the shared wheel when the earliest timer is due, then sleeps until the next one.
+ */
+static void MKASchedulerSystemTick(void) {
+    _isAdvancing = YES;
+    MKATimerWheelAdvance(&_wheel, CACurrentMediaTime());
+    _isAdvancing = NO;
+
+    // The one-shot timer has fired, so it is set again even if it fired a bit early and the deadline is the same.
+    _armedDeadline = -1;
+    MKASchedulerSystemRearm();
+}
+
+static MKAClockTimer MKASchedulerSystemSchedule(void *context, double delay, MKAClockCallback callback, void *info) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        MKATimerWheelInit(&_wheel,
+                          _wheelSlots,
+                          sizeof(_wheelSlots) / sizeof(_wheelSlots[0]),
+                          _wheelEntries,
+                          sizeof(_wheelEntries) / sizeof(_wheelEntries[0]),
+                          kTickInterval,
+                          CACurrentMediaTime());
+
+        _tickSource = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, dispatch_get_main_queue());
+        dispatch_source_set_event_handler(_tickSource, ^{
+            MKASchedulerSystemTick();
+        });
+    });
+
+    const MKAClockTimer timer = MKATimerWheelArm(&_wheel, CACurrentMediaTime(), delay, callback, info);
+
+    if (timer == 0) {
+        static MKAClockTimer lastOverflowTimer = 0;
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t) (delay * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+            callback(info);
+        });
+
+        return kOverflowTimerBit | ++lastOverflowTimer;
+    }
+
+    // The tick rearms the source after all expired timers have fired.
+    if (!_isAdvancing) {
+        MKASchedulerSystemRearm();
+    }
+
+    return timer;
+}
+
+static void MKASchedulerSystemCancel(void *context, MKAClockTimer timer) {
+    // A canceled overflow timer is skipped when it fires, because its work has been removed.
+    if ((timer & kOverflowTimerBit) == 0 && MKATimerWheelCancel(&_wheel, timer) && !_isAdvancing) {
+        MKASchedulerSystemRearm();
+    }
+}
+
+static MKAClock _systemClock = {
+    NULL,
+    MKASchedulerSystemNow,
+    MKASchedulerSystemSchedule,
+    MKASchedulerSystemCancel,
+};
+
+static MKAClock _currentClock;
+static BOOL _hasCustomClock = NO;
+static NSMutableDictionary<NSNumber *, MKAScheduledWork *> *_scheduledWorks = nil;
+static MKAClockTimer _lastToken = 0;
+
+static void MKASchedulerFire(void *info) {
+    NSNumber *token = @((MKAClockTimer) (uintptr_t) info);
+    MKAScheduledWork *scheduledWork = _scheduledWorks[token];
+
+    if (!scheduledWork) {
+        return;
+    }
+
+    [_scheduledWorks removeObjectForKey:token];
+    scheduledWork.work();
+}
+
+const MKAClock *MKASchedulerSystemClock(void) {
+    return &_systemClock;
+}
+
+const MKAClock *MKASchedulerCurrentClock(void) {
+    return _hasCustomClock ? &_currentClock : &_systemClock;
+}
+
+void MKASchedulerSetClock(const MKAClock *_Nullable clock) {
+    _hasCustomClock = clock != NULL;
+
+    if (clock) {
+        _currentClock = *clock;
+    }
+}
+
+NSTimeInterval MKASchedulerNow(void) {
+    return MKAClockNow(MKASchedulerCurrentClock());
+}
+
+MKAClockTimer MKASchedulerSchedule(NSTimeInterval delay, dispatch_block_t work) {
+    if (!_scheduledWorks) {
+        _scheduledWorks = [NSMutableDictionary dictionary];
+    }
+
+    const MKAClockTimer token = ++_lastToken;
+    MKAScheduledWork *scheduledWork = [MKAScheduledWork new];
+    scheduledWork.work = work;
+    _scheduledWorks[@(token)] = scheduledWork;
+
+    // Passes the token instead of the work, so the clock does not have to manage the lifetime of the block.
+    scheduledWork.timer = MKAClockSchedule(MKASchedulerCurrentClock(), delay, MKASchedulerFire, (void *) (uintptr_t) token);
+
+    if (scheduledWork.timer == 0) {
+        [_scheduledWorks removeObjectForKey:@(token)];
+        return 0;
+    }
+
+    return token;
+}
+
+void MKASchedulerCancel(MKAClockTimer token) {
+    MKAScheduledWork *scheduledWork = token != 0 ? _scheduledWorks[@(token)] : nil;
+
+    if (!scheduledWork) {
+        return;
+    }
+
+    [_scheduledWorks removeObjectForKey:@(token)];
+    MKAClockCancel(MKASchedulerCurrentClock(), scheduledWork.timer);
+}
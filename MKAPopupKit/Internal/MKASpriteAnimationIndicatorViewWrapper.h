@@ -32,9 +32,23 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (nonatomic) double duration;
 @property (nonatomic) NSInteger repeatCount;
+/**
+ * The maximum frame rate. 0 means no limit.
+ */
+@property (nonatomic) NSInteger framesPerSecond;
 
 - (void)setSpriteImagesWithFormat:(NSString *)format count:(NSInteger)count;
 - (void)setSpriteImagesWithArray:(NSArray<UIImage *> *)images;
+/**
+ * Sets the sprite frames decoded on demand instead of loading all frames up front.
+ */
+- (void)setStreamingSpriteImagesWithFormat:(NSString *)format count:(NSInteger)count;
+/**
+ * Sets the animated image like GIF or APNG whose frames are decoded on demand.
+ * The delay of each frame in the file is used instead of `duration`.
+ */
+- (void)setStreamingAnimatedImageData:(NSData *)data;
+- (void)setStreamingAnimatedImageURL:(NSURL *)url;
 
 @end
 
@@ -24,11 +24,27 @@
 
 #import "MKASpriteAnimationIndicatorViewWrapper.h"
 
-@interface MKASpriteAnimationIndicatorViewWrapper ()
+#import "MKAAnimationDriver.h"
+#import "MKASpriteFrameSource.h"
+
+static NSString *const kSpriteAnimationKey = @"jp.hituzi.MKAIndicator.SpriteAnimationKey";
+
+@interface MKASpriteAnimationIndicatorViewWrapper () <MKAAnimationTimeline>
 
 @property (nonatomic) UIView *containerView;
 @property (nonatomic) UIImageView *imageView;
 @property (nonatomic, copy, readonly) NSMutableArray<UIImage *> *images;
+@property (nonatomic, copy, nullable) NSArray<NSString *> *imageNames;
+@property (nonatomic, copy, nullable) NSArray<UIImage *> *preparedImages;
+@property (nonatomic, nullable) MKASpriteFrameSource *frameSource;
+/**
+ * Tells whether the streaming frames are updated by the animation driver.
+ */
+@property (nonatomic) BOOL isStreaming;
+@property (nonatomic) BOOL isStreamingPaused;
+@property (nonatomic) NSInteger streamingFramesPerSecond;
+@property (nonatomic) CFTimeInterval startTime;
+@property (nonatomic) CFTimeInterval pausedTime;
 
 @end
 
@@ -55,14 +71,82 @@
 }
 
 - (void)startAnimating {
-    self.imageView.animationImages = self.images;
-    self.imageView.animationDuration = self.duration;
-    self.imageView.animationRepeatCount = self.repeatCount;
-    [self.imageView startAnimating];
+    if (self.frameSource) {
+        [self startStreaming];
+        return;
+    }
+
+    NSArray<UIImage *> *images = self.preparedImages ?: self.images;
+
+    if (images.count == 0) {
+        return;
+    }
+
+    const NSInteger step = MKAIndicatorFrameStep((NSInteger) images.count, self.duration, self.framesPerSecond);
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:images.count / step + 1];
+
+    for (NSUInteger i = 0; i < images.count; i += step) {
+        [values addObject:(__bridge id) images[i].CGImage];
+    }
+
+    // The render server switches the frames, so nothing runs on the main thread per frame.
+    CAKeyframeAnimation *animation = [CAKeyframeAnimation animationWithKeyPath:@"contents"];
+    animation.values = values;
+    animation.calculationMode = kCAAnimationDiscrete;
+    animation.duration = self.duration;
+    animation.repeatCount = self.repeatCount > 0 ? self.repeatCount : HUGE_VALF;
+    // An endless animation survives the app going to the background. A finite one is removed when it ends, so the image
+    // view returns to its resting image as UIImageView animations do.
+    animation.removedOnCompletion = self.repeatCount > 0;
+    animation.fillMode = kCAFillModeForwards;
+
+    if (@available(iOS 15.0, *)) {
+        if (self.framesPerSecond > 0) {
+            const float framesPerSecond = (float) self.framesPerSecond;
+            animation.preferredFrameRateRange = CAFrameRateRangeMake(framesPerSecond, framesPerSecond, framesPerSecond);
+        }
+    }
+
+    [self.imageView.layer addAnimation:animation forKey:kSpriteAnimationKey];
 }
 
 - (void)stopAnimating {
-    [self.imageView stopAnimating];
+    self.isStreaming = NO;
+    self.isStreamingPaused = NO;
+    [[MKAAnimationDriver sharedDriver] removeTimeline:self];
+    [self.imageView.layer removeAnimationForKey:kSpriteAnimationKey];
+}
+
+- (void)pauseAnimating {
+    if (!self.isStreaming || self.isStreamingPaused) {
+        return;
+    }
+
+    self.isStreamingPaused = YES;
+    [[MKAAnimationDriver sharedDriver] removeTimeline:self];
+    self.pausedTime = CACurrentMediaTime();
+}
+
+- (void)resumeAnimating {
+    if (!self.isStreamingPaused) {
+        return;
+    }
+
+    // Shifts the start time by the paused duration so that the animation continues from the paused frame.
+    if (self.startTime > 0) {
+        self.startTime += CACurrentMediaTime() - self.pausedTime;
+    }
+
+    self.isStreamingPaused = NO;
+    [[MKAAnimationDriver sharedDriver] addTimeline:self];
+}
+
+- (NSArray<UIImage *> *)sourceImages {
+    return [self.images copy];
+}
+
+- (NSArray<NSString *> *)sourceImageNames {
+    return self.imageNames ?: @[];
 }
 
 #pragma mark - public method
@@ -72,12 +156,20 @@
         return;
     }
 
+    self.frameSource = nil;
+    self.preparedImages = nil;
     [self.images removeAllObjects];
 
+    NSMutableArray<NSString *> *imageNames = [NSMutableArray arrayWithCapacity:(NSUInteger) count];
+
     for (NSInteger i = 0; i < count; i++) {
-        [self.images addObject:[UIImage imageNamed:[NSString stringWithFormat:format, i]]];
+        NSString *name = [NSString stringWithFormat:format, i];
+        [self.images addObject:[UIImage imageNamed:name]];
+        [imageNames addObject:name];
     }
 
+    self.imageNames = imageNames;
+
     self.containerView.bounds = (CGRect) { CGPointZero, self.images[0].size };
 }
 
@@ -86,10 +178,103 @@
         return;
     }
 
+    self.frameSource = nil;
+    self.preparedImages = nil;
+    self.imageNames = nil;
     [self.images removeAllObjects];
     [self.images addObjectsFromArray:images];
 
     self.containerView.bounds = (CGRect) { CGPointZero, self.images[0].size };
 }
 
+- (void)setStreamingSpriteImagesWithFormat:(NSString *)format count:(NSInteger)count {
+    [self setStreamingFrameSource:[MKASpriteFrameSource frameSourceWithFormat:format count:count]];
+}
+
+- (void)setStreamingAnimatedImageData:(NSData *)data {
+    [self setStreamingFrameSource:[MKASpriteFrameSource frameSourceWithAnimatedImageData:data]];
+}
+
+- (void)setStreamingAnimatedImageURL:(NSURL *)url {
+    [self setStreamingFrameSource:[MKASpriteFrameSource frameSourceWithAnimatedImageURL:url]];
+}
+
+#pragma mark - private method
+
+- (void)setStreamingFrameSource:(nullable MKASpriteFrameSource *)frameSource {
+    if (!frameSource) {
+        return;
+    }
+
+    [self.images removeAllObjects];
+    self.preparedImages = nil;
+    self.imageNames = nil;
+    self.frameSource = frameSource;
+
+    self.containerView.bounds = (CGRect) { CGPointZero, frameSource.frameSize };
+}
+
+- (void)startStreaming {
+    self.startTime = 0;
+    // Starts decoding the first frames before the first tick.
+    self.imageView.image = [self.frameSource frameAtIndex:0];
+
+    const NSTimeInterval loopDuration = self.frameSource.totalDuration > 0 ? self.frameSource.totalDuration : self.duration;
+    NSInteger framesPerSecond = (NSInteger) ceil(self.frameSource.count / MAX(loopDuration, .001));
+    if (self.framesPerSecond > 0) {
+        framesPerSecond = MIN(framesPerSecond, self.framesPerSecond);
+    }
+    self.streamingFramesPerSecond = framesPerSecond;
+    self.isStreaming = YES;
+    self.isStreamingPaused = NO;
+
+    MKAAnimationDriver *driver = [MKAAnimationDriver sharedDriver];
+    [driver addTimeline:self];
+    [driver setNeedsUpdateFrameRate];
+}
+
+#pragma mark - MKAAnimationTimeline
+
+- (NSInteger)preferredFramesPerSecond {
+    return self.streamingFramesPerSecond;
+}
+
+- (BOOL)stepAtTime:(CFTimeInterval)timestamp {
+    if (self.startTime == 0) {
+        self.startTime = timestamp;
+    }
+
+    const CFTimeInterval elapsed = timestamp - self.startTime;
+    const NSInteger count = self.frameSource.count;
+    const NSTimeInterval totalDuration = self.frameSource.totalDuration;
+    NSInteger loop;
+    NSInteger frame;
+
+    if (totalDuration > 0) {
+        // Honors the delay of each frame in the animated image.
+        loop = (NSInteger) (elapsed / totalDuration);
+        frame = [self.frameSource frameIndexAtTime:elapsed - loop * totalDuration];
+    }
+    else {
+        // A zero duration would make the position infinite, so the loop is clamped as in `startStreaming`.
+        const NSInteger position = (NSInteger) (elapsed / MAX(self.duration, .001) * count);
+        loop = position / count;
+        frame = position % count;
+    }
+
+    if (self.repeatCount > 0 && loop >= self.repeatCount) {
+        self.isStreaming = NO;
+        return NO;
+    }
+
+    // Keeps the previous frame when the next one has not been decoded yet.
+    UIImage *image = [self.frameSource frameAtIndex:frame];
+
+    if (image) {
+        self.imageView.image = image;
+    }
+
+    return YES;
+}
+
 @end
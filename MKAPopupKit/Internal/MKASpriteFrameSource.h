@@ -0,0 +1,85 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A set of sprite frames decoded on demand.
+ * Only a few decoded frames are kept in the ring buffer and following frames are prefetched in the background.
+ */
+@interface MKASpriteFrameSource : NSObject
+/**
+ * Number of frames.
+ */
+@property (nonatomic, readonly) NSInteger count;
+/**
+ * The size of a frame.
+ */
+@property (nonatomic, readonly) CGSize frameSize;
+/**
+ * The duration of each frame read from the animated image. nil when the frames are evenly spaced.
+ */
+@property (nonatomic, readonly, nullable) NSArray<NSNumber *> *frameDurations;
+/**
+ * The sum of `frameDurations`. 0 when the frames are evenly spaced.
+ */
+@property (nonatomic, readonly) NSTimeInterval totalDuration;
+
+/**
+ * Returns the frame source for given file name format and number of frames.
+ * The frame source is shared while any indicator uses it.
+ */
++ (nullable instancetype)frameSourceWithFormat:(NSString *)format count:(NSInteger)count;
+/**
+ * Returns the frame source for given animated image data like GIF or APNG.
+ * The frames are decoded incrementally from the container.
+ */
++ (nullable instancetype)frameSourceWithAnimatedImageData:(NSData *)data;
+/**
+ * Returns the frame source for given animated image file like GIF or APNG.
+ * The frames are decoded incrementally from the container.
+ */
++ (nullable instancetype)frameSourceWithAnimatedImageURL:(NSURL *)url;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Returns the decoded frame if it is ready, otherwise nil. Following frames are prefetched in the background.
+ */
+- (nullable UIImage *)frameAtIndex:(NSInteger)index;
+/**
+ * Returns the index of the frame displayed at given time from the beginning of a loop.
+ * It is available when `frameDurations` is not nil.
+ */
+- (NSInteger)frameIndexAtTime:(NSTimeInterval)time;
+/**
+ * Discards all decoded frames.
+ */
+- (void)purge;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,376 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKASpriteFrameSource.h"
+
+#import <ImageIO/ImageIO.h>
+
+#import "MKADecodedImageCache.h"
+#import "MKAPopupKitHelper.h"
+
+/**
+ * Number of decoded frames kept in memory.
+ */
+static const NSInteger kRingSize = 8;
+/**
+ * Number of frames decoded ahead of the current frame.
+ */
+static const NSInteger kPrefetchCount = 4;
+/**
+ * The frame duration used when the animated image has no valid delay like web browsers.
+ */
+static const NSTimeInterval kDefaultFrameDuration = .1;
+
+@interface MKASpriteFrameSource ()
+
+@property (nonatomic, copy, nullable) NSString *format;
+@property (nonatomic, nullable) CGImageSourceRef imageSource;
+@property (nonatomic) NSInteger count;
+@property (nonatomic) CGSize frameSize;
+@property (nonatomic, copy, nullable) NSArray<NSNumber *> *frameDurations;
+@property (nonatomic) NSTimeInterval totalDuration;
+/**
+ * The end time of each frame from the beginning of a loop.
+ */
+@property (nonatomic, copy, nullable) NSArray<NSNumber *> *frameEndTimes;
+@property (nonatomic) CGFloat screenScale;
+@property (nonatomic) NSMutableArray *ring;
+@property (nonatomic) NSMutableArray<NSNumber *> *ringIndexes;
+@property (nonatomic) NSMutableIndexSet *pendingIndexes;
+@property (nonatomic) dispatch_queue_t decodeQueue;
+
+@end
+
+@implementation MKASpriteFrameSource
+
+static NSMapTable<NSString *, MKASpriteFrameSource *> *_sharedSources = nil;
+
++ (nullable instancetype)frameSourceWithFormat:(NSString *)format count:(NSInteger)count {
+    if (!format || count <= 0) {
+        return nil;
+    }
+
+    NSString *key = [NSString stringWithFormat:@"format:%@:%ld", format, (long) count];
+
+    return [self sharedFrameSourceForKey:key creation:^MKASpriteFrameSource * {
+        MKASpriteFrameSource *source = [[MKASpriteFrameSource alloc] initWithCount:count];
+        source.format = format;
+        return [source setUp] ? source : nil;
+    }];
+}
+
++ (nullable instancetype)frameSourceWithAnimatedImageData:(NSData *)data {
+    if (data.length == 0) {
+        return nil;
+    }
+
+    // The data is retained by the image source, so its address identifies the frame source while it is alive.
+    NSString *key = [NSString stringWithFormat:@"data:%p", data];
+
+    return [self sharedFrameSourceForKey:key creation:^MKASpriteFrameSource * {
+        CGImageSourceRef imageSource = CGImageSourceCreateWithData((__bridge CFDataRef) data, NULL);
+        return [self frameSourceWithImageSource:imageSource];
+    }];
+}
+
++ (nullable instancetype)frameSourceWithAnimatedImageURL:(NSURL *)url {
+    if (!url) {
+        return nil;
+    }
+
+    NSString *key = [NSString stringWithFormat:@"url:%@", url.absoluteString];
+
+    return [self sharedFrameSourceForKey:key creation:^MKASpriteFrameSource * {
+        CGImageSourceRef imageSource = CGImageSourceCreateWithURL((__bridge CFURLRef) url, NULL);
+        return [self frameSourceWithImageSource:imageSource];
+    }];
+}
+
++ (nullable MKASpriteFrameSource *)sharedFrameSourceForKey:(NSString *)key
+                                                  creation:(MKASpriteFrameSource *_Nullable (^)(void))creation {
+    @synchronized (self) {
+        if (!_sharedSources) {
+            _sharedSources = [NSMapTable strongToWeakObjectsMapTable];
+        }
+
+        MKASpriteFrameSource *source = [_sharedSources objectForKey:key];
+
+        if (!source) {
+            source = creation();
+
+            if (source) {
+                [_sharedSources setObject:source forKey:key];
+            }
+        }
+
+        return source;
+    }
+}
+
+/**
+ * Creates the frame source taking the ownership of given image source.
+ */
++ (nullable MKASpriteFrameSource *)frameSourceWithImageSource:(nullable CGImageSourceRef)imageSource {
+    if (!imageSource) {
+        return nil;
+    }
+
+    const NSInteger count = (NSInteger) CGImageSourceGetCount(imageSource);
+
+    if (count <= 0) {
+        CFRelease(imageSource);
+        return nil;
+    }
+
+    MKASpriteFrameSource *source = [[MKASpriteFrameSource alloc] initWithCount:count];
+    source.imageSource = imageSource;
+    [source readFrameDurations];
+
+    return [source setUp] ? source : nil;
+}
+
+- (instancetype)initWithCount:(NSInteger)count {
+    if (self = [super init]) {
+        _count = count;
+        _screenScale = [UIScreen mainScreen].scale;
+        _ring = [NSMutableArray arrayWithCapacity:kRingSize];
+        _ringIndexes = [NSMutableArray arrayWithCapacity:kRingSize];
+        _pendingIndexes = [NSMutableIndexSet indexSet];
+        _decodeQueue = dispatch_queue_create("jp.hituzi.MKAIndicator.SpriteDecodeQueue", DISPATCH_QUEUE_SERIAL);
+
+        for (NSInteger i = 0; i < kRingSize; i++) {
+            [_ring addObject:[NSNull null]];
+            [_ringIndexes addObject:@(NSNotFound)];
+        }
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    if (_imageSource) {
+        CFRelease(_imageSource);
+    }
+}
+
+/**
+ * Reads the frame size and starts observing memory warnings. Returns NO if the first frame is not available.
+ */
+- (BOOL)setUp {
+    if (self.imageSource) {
+        NSDictionary *properties = (__bridge_transfer NSDictionary *) CGImageSourceCopyPropertiesAtIndex(self.imageSource, 0, NULL);
+        const CGFloat width = [properties[(__bridge NSString *) kCGImagePropertyPixelWidth] doubleValue];
+        const CGFloat height = [properties[(__bridge NSString *) kCGImagePropertyPixelHeight] doubleValue];
+
+        if (width <= 0 || height <= 0) {
+            return NO;
+        }
+
+        self.frameSize = CGSizeMake(width, height);
+    }
+    else {
+        // Reads the size only. The first frame is decoded when it is needed.
+        UIImage *firstFrame = [self loadFrameAtIndex:0];
+
+        if (!firstFrame) {
+            return NO;
+        }
+
+        self.frameSize = firstFrame.size;
+    }
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(purge)
+                                                 name:UIApplicationDidReceiveMemoryWarningNotification
+                                               object:nil];
+
+    return YES;
+}
+
+- (void)readFrameDurations {
+    NSMutableArray<NSNumber *> *durations = [NSMutableArray arrayWithCapacity:(NSUInteger) self.count];
+    NSMutableArray<NSNumber *> *endTimes = [NSMutableArray arrayWithCapacity:(NSUInteger) self.count];
+    NSTimeInterval totalDuration = 0;
+
+    for (NSInteger i = 0; i < self.count; i++) {
+        NSDictionary *properties = (__bridge_transfer NSDictionary *) CGImageSourceCopyPropertiesAtIndex(self.imageSource, (size_t) i, NULL);
+        NSDictionary *gif = properties[(__bridge NSString *) kCGImagePropertyGIFDictionary];
+        NSDictionary *png = properties[(__bridge NSString *) kCGImagePropertyPNGDictionary];
+        NSNumber *delay = gif[(__bridge NSString *) kCGImagePropertyGIFUnclampedDelayTime]
+            ?: gif[(__bridge NSString *) kCGImagePropertyGIFDelayTime]
+            ?: png[(__bridge NSString *) kCGImagePropertyAPNGUnclampedDelayTime]
+            ?: png[(__bridge NSString *) kCGImagePropertyAPNGDelayTime];
+        NSTimeInterval duration = delay.doubleValue;
+
+        // Too short delays are treated as the default like web browsers.
+        if (duration < .011) {
+            duration = kDefaultFrameDuration;
+        }
+
+        totalDuration += duration;
+        [durations addObject:@(duration)];
+        [endTimes addObject:@(totalDuration)];
+    }
+
+    self.frameDurations = durations;
+    self.frameEndTimes = endTimes;
+    self.totalDuration = totalDuration;
+}
+
+#pragma mark - public method
+
+- (nullable UIImage *)frameAtIndex:(NSInteger)index {
+    UIImage *frame = nil;
+
+    @synchronized (self) {
+        const NSInteger slot = index % kRingSize;
+
+        if (self.ringIndexes[slot].integerValue == index) {
+            frame = self.ring[slot];
+        }
+    }
+
+    [self prefetchFromIndex:index];
+
+    return frame;
+}
+
+- (NSInteger)frameIndexAtTime:(NSTimeInterval)time {
+    if (!self.frameEndTimes) {
+        return 0;
+    }
+
+    // Finds the first frame that ends after given time.
+    const NSUInteger index = [self.frameEndTimes indexOfObject:@(time)
+                                                 inSortedRange:NSMakeRange(0, self.frameEndTimes.count)
+                                                       options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                               usingComparator:^NSComparisonResult(NSNumber *obj1, NSNumber *obj2) {
+                                                   return [obj1 compare:obj2];
+                                               }];
+
+    return MIN((NSInteger) index, self.count - 1);
+}
+
+- (void)purge {
+    @synchronized (self) {
+        for (NSInteger i = 0; i < kRingSize; i++) {
+            self.ring[i] = [NSNull null];
+            self.ringIndexes[i] = @(NSNotFound);
+        }
+    }
+}
+
+#pragma mark - private method
+
+- (void)prefetchFromIndex:(NSInteger)index {
+    // The current frame is also requested when it is missing.
+    for (NSInteger i = 0; i <= kPrefetchCount; i++) {
+        const NSInteger frameIndex = (index + i) % self.count;
+
+        @synchronized (self) {
+            if (self.ringIndexes[frameIndex % kRingSize].integerValue == frameIndex || [self.pendingIndexes containsIndex:(NSUInteger) frameIndex]) {
+                continue;
+            }
+
+            [self.pendingIndexes addIndex:(NSUInteger) frameIndex];
+        }
+
+        dispatch_async(self.decodeQueue, ^{
+            UIImage *decoded = [self decodeFrameAtIndex:frameIndex];
+
+            @synchronized (self) {
+                [self.pendingIndexes removeIndex:(NSUInteger) frameIndex];
+
+                if (decoded) {
+                    const NSInteger slot = frameIndex % kRingSize;
+                    self.ring[slot] = decoded;
+                    self.ringIndexes[slot] = @(frameIndex);
+                }
+            }
+        });
+    }
+}
+
+- (nullable UIImage *)decodeFrameAtIndex:(NSInteger)index {
+    if (!self.imageSource) {
+        NSString *name = [NSString stringWithFormat:self.format, index];
+        MKADecodedImageCache *cache = [MKADecodedImageCache sharedCache];
+
+        if (!cache.isEnabled) {
+            return [MKAPopupKitHelper decodedImage:[self loadFrameNamed:name]];
+        }
+
+        // Reads the bitmap decoded in the previous launch without loading the file.
+        UIImage *cachedImage = [cache imageForName:name size:self.frameSize scale:self.screenScale];
+
+        if (cachedImage) {
+            return cachedImage;
+        }
+
+        UIImage *image = [self loadFrameNamed:name];
+
+        return image ? [cache decodedImage:image name:name size:self.frameSize scale:self.screenScale] : nil;
+    }
+
+    // Decodes only the requested frame from the container.
+    NSDictionary *options = @{ (__bridge NSString *) kCGImageSourceShouldCacheImmediately: @YES };
+    CGImageRef imageRef = CGImageSourceCreateImageAtIndex(self.imageSource, (size_t) index, (__bridge CFDictionaryRef) options);
+
+    if (!imageRef) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef];
+    CGImageRelease(imageRef);
+
+    return image;
+}
+
+- (nullable UIImage *)loadFrameAtIndex:(NSInteger)index {
+    return [self loadFrameNamed:[NSString stringWithFormat:self.format, index]];
+}
+
+- (nullable UIImage *)loadFrameNamed:(NSString *)name {
+    NSBundle *bundle = [NSBundle mainBundle];
+
+    // Loads the file directly so that the system image cache does not keep all frames.
+    NSMutableArray<NSString *> *names = [NSMutableArray array];
+    for (NSInteger scale = (NSInteger) self.screenScale; scale > 1; scale--) {
+        [names addObject:[NSString stringWithFormat:@"%@@%ldx", name, (long) scale]];
+    }
+    [names addObject:name];
+
+    for (NSString *candidate in names) {
+        NSString *path = [bundle pathForResource:candidate ofType:@"png"];
+
+        if (path) {
+            return [UIImage imageWithContentsOfFile:path];
+        }
+    }
+
+    // Falls back on the asset catalog.
+    return [UIImage imageNamed:name];
+}
+
+@end
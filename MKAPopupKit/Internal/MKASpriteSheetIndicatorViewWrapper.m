@@ -0,0 +1,154 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKASpriteSheetIndicatorViewWrapper.h"
+
+static NSString *const kSpriteSheetAnimationKey = @"jp.hituzi.MKAIndicator.SpriteSheetAnimationKey";
+
+@interface MKASpriteSheetIndicatorViewWrapper ()
+
+@property (nonatomic) UIView *containerView;
+@property (nonatomic) UIView *frameView;
+/**
+ * The frames in the unit coordinate space of the sprite sheet.
+ */
+@property (nonatomic, copy) NSArray<NSValue *> *contentsRects;
+
+@end
+
+@implementation MKASpriteSheetIndicatorViewWrapper
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _containerView = [UIView new];
+        _frameView = [UIView new];
+        _frameView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        _frameView.layer.contentsGravity = kCAGravityResizeAspect;
+        [_containerView addSubview:_frameView];
+        _duration = MKAIndicatorDefaultAnimationDuration;
+        _repeatCount = 0;   // Infinite
+        _contentsRects = @[];
+    }
+
+    return self;
+}
+
+#pragma mark - MKAIndicatorInterface
+
+- (UIView *)view {
+    return self.containerView;
+}
+
+- (void)startAnimating {
+    if (self.contentsRects.count == 0) {
+        return;
+    }
+
+    // All frames are in one texture. The render server only switches the visible region.
+    NSArray<NSValue *> *values = self.contentsRects;
+    const NSInteger step = MKAIndicatorFrameStep((NSInteger) values.count, self.duration, self.framesPerSecond);
+
+    if (step > 1) {
+        NSMutableArray<NSValue *> *steppedValues = [NSMutableArray arrayWithCapacity:values.count / step + 1];
+
+        for (NSUInteger i = 0; i < values.count; i += step) {
+            [steppedValues addObject:values[i]];
+        }
+
+        values = steppedValues;
+    }
+
+    CAKeyframeAnimation *animation = [CAKeyframeAnimation animationWithKeyPath:@"contentsRect"];
+    animation.values = values;
+    animation.calculationMode = kCAAnimationDiscrete;
+    animation.duration = self.duration;
+    animation.repeatCount = self.repeatCount > 0 ? self.repeatCount : HUGE_VALF;
+    // Do not restore when animation ends.
+    animation.removedOnCompletion = NO;
+    animation.fillMode = kCAFillModeForwards;
+
+    if (@available(iOS 15.0, *)) {
+        if (self.framesPerSecond > 0) {
+            const float framesPerSecond = (float) self.framesPerSecond;
+            animation.preferredFrameRateRange = CAFrameRateRangeMake(framesPerSecond, framesPerSecond, framesPerSecond);
+        }
+    }
+
+    [self.frameView.layer addAnimation:animation forKey:kSpriteSheetAnimationKey];
+}
+
+- (void)stopAnimating {
+    [self.frameView.layer removeAnimationForKey:kSpriteSheetAnimationKey];
+}
+
+#pragma mark - public method
+
+- (void)setSpriteSheet:(UIImage *)image columns:(NSInteger)columns rows:(NSInteger)rows count:(NSInteger)count {
+    if (columns <= 0 || rows <= 0) {
+        return;
+    }
+
+    const CGFloat width = image.size.width / columns;
+    const CGFloat height = image.size.height / rows;
+    const NSInteger frameCount = count > 0 ? MIN(count, columns * rows) : columns * rows;
+    NSMutableArray<NSValue *> *frameRects = [NSMutableArray arrayWithCapacity:(NSUInteger) frameCount];
+
+    // Frames are ordered from left to right, top to bottom.
+    for (NSInteger i = 0; i < frameCount; i++) {
+        [frameRects addObject:[NSValue valueWithCGRect:CGRectMake(width * (i % columns),
+                                                                  height * (i / columns),
+                                                                  width,
+                                                                  height)]];
+    }
+
+    [self setSpriteSheet:image frameRects:frameRects];
+}
+
+- (void)setSpriteSheet:(UIImage *)image frameRects:(NSArray<NSValue *> *)frameRects {
+    const CGSize imageSize = image.size;
+
+    if (frameRects.count == 0 || imageSize.width <= 0 || imageSize.height <= 0) {
+        return;
+    }
+
+    NSMutableArray<NSValue *> *contentsRects = [NSMutableArray arrayWithCapacity:frameRects.count];
+
+    for (NSValue *value in frameRects) {
+        const CGRect rect = value.CGRectValue;
+        [contentsRects addObject:[NSValue valueWithCGRect:CGRectMake(rect.origin.x / imageSize.width,
+                                                                     rect.origin.y / imageSize.height,
+                                                                     rect.size.width / imageSize.width,
+                                                                     rect.size.height / imageSize.height)]];
+    }
+
+    self.contentsRects = contentsRects;
+
+    self.frameView.layer.contents = (__bridge id) image.CGImage;
+    self.frameView.layer.contentsScale = image.scale;
+    self.frameView.layer.contentsRect = contentsRects.firstObject.CGRectValue;
+
+    self.containerView.bounds = (CGRect) { CGPointZero, frameRects.firstObject.CGRectValue.size };
+}
+
+@end
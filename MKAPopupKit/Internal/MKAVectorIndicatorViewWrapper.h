@@ -0,0 +1,52 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+#import "MKAIndicatorInterface.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * An indicator drawn with shape layers. The rotation and the stroke are animated by the render server,
+ * and no bitmap is decoded or kept.
+ */
+@interface MKAVectorIndicatorViewWrapper : NSObject <MKAIndicatorInterface>
+
+@property (nonatomic) double duration;
+@property (nonatomic) float repeatCount;
+@property (nonatomic) UIColor *strokeColor;
+/**
+ * A color of the whole circle drawn behind the arc. No circle is drawn if it is nil.
+ */
+@property (nonatomic, nullable) UIColor *trackColor;
+@property (nonatomic) CGFloat lineWidth;
+/**
+ * The maximum length of the arc as a fraction of the circle between 0 and 1.
+ */
+@property (nonatomic) CGFloat arcLength;
+
+@end
+
+NS_ASSUME_NONNULL_END
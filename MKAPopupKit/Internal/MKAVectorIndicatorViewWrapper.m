@@ -0,0 +1,161 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAVectorIndicatorViewWrapper.h"
+
+static NSString *const kStrokeAnimationKey = @"jp.hituzi.MKAIndicator.StrokeAnimationKey";
+
+/**
+ * A view that fits the circle paths of its shape layers to its bounds.
+ */
+@interface MKAVectorSpinnerView : UIView
+
+@property (nonatomic) CAShapeLayer *trackLayer;
+@property (nonatomic) CAShapeLayer *arcLayer;
+
+@end
+
+@implementation MKAVectorSpinnerView
+
+- (instancetype)initWithFrame:(CGRect)frame {
+    if (self = [super initWithFrame:frame]) {
+        _trackLayer = [self makeShapeLayer];
+        _arcLayer = [self makeShapeLayer];
+        _arcLayer.lineCap = kCALineCapRound;
+        [self.layer addSublayer:_trackLayer];
+        [self.layer addSublayer:_arcLayer];
+    }
+
+    return self;
+}
+
+- (void)layoutSubviews {
+    [super layoutSubviews];
+
+    const CGFloat inset = self.arcLayer.lineWidth / 2.f;
+    UIBezierPath *path = [UIBezierPath bezierPathWithOvalInRect:CGRectInset(self.bounds, inset, inset)];
+
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+    for (CAShapeLayer *layer in @[self.trackLayer, self.arcLayer]) {
+        layer.frame = self.bounds;
+        layer.path = path.CGPath;
+    }
+    [CATransaction commit];
+}
+
+- (CAShapeLayer *)makeShapeLayer {
+    CAShapeLayer *layer = [CAShapeLayer layer];
+    layer.fillColor = nil;
+    // Draws the path at the resolution of the screen.
+    layer.contentsScale = UIScreen.mainScreen.scale;
+
+    return layer;
+}
+
+@end
+
+@interface MKAVectorIndicatorViewWrapper ()
+
+@property (nonatomic) MKAVectorSpinnerView *spinnerView;
+
+@end
+
+@implementation MKAVectorIndicatorViewWrapper
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _spinnerView = [[MKAVectorSpinnerView alloc] initWithFrame:CGRectMake(0, 0, 32.f, 32.f)];
+        _duration = MKAIndicatorDefaultAnimationDuration;
+        _repeatCount = MKAIndicatorDefaultRepeatCount;
+        self.strokeColor = UIColor.systemGrayColor;
+        self.lineWidth = 3.f;
+        self.arcLength = .75f;
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (void)setStrokeColor:(UIColor *)strokeColor {
+    _strokeColor = strokeColor;
+    self.spinnerView.arcLayer.strokeColor = strokeColor.CGColor;
+}
+
+- (void)setTrackColor:(nullable UIColor *)trackColor {
+    _trackColor = trackColor;
+    self.spinnerView.trackLayer.strokeColor = trackColor.CGColor;
+}
+
+- (void)setLineWidth:(CGFloat)lineWidth {
+    _lineWidth = lineWidth;
+    self.spinnerView.trackLayer.lineWidth = lineWidth;
+    self.spinnerView.arcLayer.lineWidth = lineWidth;
+    [self.spinnerView setNeedsLayout];
+}
+
+- (void)setArcLength:(CGFloat)arcLength {
+    _arcLength = MIN(MAX(arcLength, 0), 1.f);
+    self.spinnerView.arcLayer.strokeEnd = _arcLength;
+}
+
+#pragma mark - MKAIndicatorInterface
+
+- (UIView *)view {
+    return self.spinnerView;
+}
+
+- (void)startAnimating {
+    CABasicAnimation *rotation = [CABasicAnimation animationWithKeyPath:@"transform.rotation.z"];
+    rotation.duration = self.duration;
+    rotation.repeatCount = self.repeatCount;
+    rotation.fromValue = @(0);
+    rotation.toValue = @(2.0 * M_PI);
+    // Do not restore when animation ends.
+    rotation.removedOnCompletion = NO;
+    rotation.fillMode = kCAFillModeForwards;
+    [self.spinnerView.layer addAnimation:rotation forKey:MKAIndicatorRotationAnimationKey];
+
+    // Grows and shrinks the arc while it turns. Two turns make one cycle of the stroke.
+    CAKeyframeAnimation *stroke = [CAKeyframeAnimation animationWithKeyPath:@"strokeEnd"];
+    stroke.values = @[@(self.arcLength * .25f), @(self.arcLength), @(self.arcLength * .25f)];
+    stroke.keyTimes = @[@0, @.5, @1];
+    stroke.timingFunctions = @[
+        [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut],
+        [CAMediaTimingFunction functionWithName:kCAMediaTimingFunctionEaseInEaseOut],
+    ];
+    stroke.duration = self.duration * 2.0;
+    stroke.repeatCount = self.repeatCount / 2.f;
+    stroke.removedOnCompletion = NO;
+    stroke.fillMode = kCAFillModeForwards;
+    [self.spinnerView.arcLayer addAnimation:stroke forKey:kStrokeAnimationKey];
+}
+
+- (void)stopAnimating {
+    [self.spinnerView.layer removeAnimationForKey:MKAIndicatorRotationAnimationKey];
+    [self.spinnerView.arcLayer removeAnimationForKey:kStrokeAnimationKey];
+}
+
+@end
@@ -0,0 +1,56 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Resolves the window where popups, toasts and indicators are presented.
+ * The window of each scene is cached until a window becomes key, visible or hidden, or a scene is activated,
+ * deactivated or disconnected, so a lookup does not iterate the windows.
+ * All methods must be called on the main thread.
+ */
+@interface MKAWindowResolver : NSObject
+
++ (instancetype)sharedResolver;
+
+/**
+ * Returns the key window of given scene. If the scene is nil, returns the key window of the foreground active scene.
+ * A window set by `setWindow:forScene:` is returned without the lookup.
+ */
+- (nullable UIWindow *)keyWindowInScene:(nullable UIWindowScene *)scene;
+/**
+ * Uses given window for given scene instead of its key window. If the scene is nil, the window is used when no scene
+ * is given. The window is not retained and is kept over `invalidate`. Setting nil removes the override.
+ */
+- (void)setWindow:(nullable UIWindow *)window forScene:(nullable UIWindowScene *)scene;
+/**
+ * Discards the cached windows. It is called automatically by the notifications.
+ */
+- (void)invalidate;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,196 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAWindowResolver.h"
+
+@interface MKAWindowResolver ()
+
+/**
+ * The key window of each scene.
+ */
+@property (nonatomic) NSMapTable<UIWindowScene *, UIWindow *> *windows;
+@property (nonatomic, weak, nullable) UIWindow *defaultWindow;
+/**
+ * The windows set by `setWindow:forScene:`. They are not discarded by `invalidate`.
+ */
+@property (nonatomic) NSMapTable<UIWindowScene *, UIWindow *> *overrideWindows;
+@property (nonatomic, weak, nullable) UIWindow *defaultOverrideWindow;
+
+@end
+
+@implementation MKAWindowResolver
+
++ (instancetype)sharedResolver {
+    static MKAWindowResolver *resolver = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        resolver = [MKAWindowResolver new];
+    });
+
+    return resolver;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _windows = [NSMapTable weakToWeakObjectsMapTable];
+        _overrideWindows = [NSMapTable weakToWeakObjectsMapTable];
+
+        NSArray<NSNotificationName> *names = @[
+            UIWindowDidBecomeKeyNotification,
+            UIWindowDidResignKeyNotification,
+            UIWindowDidBecomeVisibleNotification,
+            UIWindowDidBecomeHiddenNotification,
+            UISceneDidActivateNotification,
+            UISceneWillDeactivateNotification,
+            UISceneDidDisconnectNotification,
+        ];
+
+        for (NSNotificationName name in names) {
+            [[NSNotificationCenter defaultCenter] addObserver:self
+                                                     selector:@selector(windowHierarchyDidChange:)
+                                                         name:name
+                                                       object:nil];
+        }
+    }
+
+    return self;
+}
+
+#pragma mark - public method
+
+- (nullable UIWindow *)keyWindowInScene:(nullable UIWindowScene *)scene {
+    UIWindow *overrideWindow = scene ? [self.overrideWindows objectForKey:scene] : self.defaultOverrideWindow;
+
+    if (overrideWindow) {
+        return overrideWindow;
+    }
+
+    if (!scene) {
+        UIWindow *window = self.defaultWindow;
+
+        if (!window) {
+            window = [self findDefaultWindow];
+            self.defaultWindow = window;
+        }
+
+        return window;
+    }
+
+    UIWindow *window = [self.windows objectForKey:scene];
+
+    if (!window) {
+        window = [self findKeyWindowInScene:scene];
+
+        if (window) {
+            [self.windows setObject:window forKey:scene];
+        }
+    }
+
+    return window;
+}
+
+- (void)setWindow:(nullable UIWindow *)window forScene:(nullable UIWindowScene *)scene {
+    if (!scene) {
+        self.defaultOverrideWindow = window;
+    }
+    else if (window) {
+        [self.overrideWindows setObject:window forKey:scene];
+    }
+    else {
+        [self.overrideWindows removeObjectForKey:scene];
+    }
+}
+
+- (void)invalidate {
+    [self.windows removeAllObjects];
+    self.defaultWindow = nil;
+}
+
+#pragma mark - private method
+
+- (void)windowHierarchyDidChange:(NSNotification *)notification {
+    [self invalidate];
+}
+
+- (nullable UIWindow *)findDefaultWindow {
+    UIWindowScene *fallbackScene = nil;
+
+    for (UIScene *scene in [UIApplication sharedApplication].connectedScenes) {
+        if (![scene isKindOfClass:UIWindowScene.class]) {
+            continue;
+        }
+        if (scene.activationState == UISceneActivationStateForegroundActive) {
+            UIWindow *window = [self findKeyWindowInScene:(UIWindowScene *) scene];
+
+            if (window) {
+                return window;
+            }
+        }
+        else if (!fallbackScene && scene.activationState == UISceneActivationStateForegroundInactive) {
+            fallbackScene = (UIWindowScene *) scene;
+        }
+    }
+
+    if (fallbackScene) {
+        return [self findKeyWindowInScene:fallbackScene];
+    }
+
+    // The app does not use scenes.
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    for (UIWindow *window in [UIApplication sharedApplication].windows) {
+        if (window.isKeyWindow) {
+            return window;
+        }
+    }
+#pragma clang diagnostic pop
+
+    return nil;
+}
+
+- (nullable UIWindow *)findKeyWindowInScene:(UIWindowScene *)scene {
+    if (@available(iOS 15.0, *)) {
+        if (scene.keyWindow) {
+            return scene.keyWindow;
+        }
+    }
+    else {
+        for (UIWindow *window in scene.windows) {
+            if (window.isKeyWindow) {
+                return window;
+            }
+        }
+    }
+
+    // Uses the front window when the scene is not key.
+    for (UIWindow *window in scene.windows.reverseObjectEnumerator) {
+        if (!window.isHidden && window.windowLevel == UIWindowLevelNormal) {
+            return window;
+        }
+    }
+
+    return nil;
+}
+
+@end
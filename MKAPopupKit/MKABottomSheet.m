@@ -24,10 +24,13 @@
 
 #import "MKABottomSheet.h"
 
+#import "MKAPopupSubclass.h"
+
 @implementation MKABottomSheet
 
 - (instancetype)initWithContentView:(__kindof UIView *)contentView {
     if (self = [super initWithContentView:contentView]) {
+        self.placement = MKAPopupPlacementBottom;
         self.showingAnimation = MKAPopupViewAnimationSlideUp;
         self.hidingAnimation = MKAPopupViewAnimationSlideDown;
         self.sheetHeight = 300.f;
@@ -36,13 +39,6 @@
     return self;
 }
 
-- (void)layoutSubviews {
-    [super layoutSubviews];
-
-    self.popupView.frame = CGRectMake(0, 0, self.frame.size.width, self.sheetHeight);
-    self.popupView.center = CGPointMake(self.frame.size.width / 2.f, self.frame.size.height - self.sheetHeight / 2.f);
-}
-
 #pragma mark - public method
 
 - (CGFloat)sheetHeight {
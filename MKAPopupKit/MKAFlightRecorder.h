@@ -0,0 +1,62 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * MKAFlightRecorder keeps the latest presentation events of MKAPopup, MKABottomSheet, MKAToast and MKAIndicator
+ * in a fixed-size ring buffer: show and hide requests, the ends of the animations, the delegate callbacks,
+ * the indicator counter and the toast queue with their times. Recording does not lock nor allocate.
+ * A dump can be replayed through the same lifecycle logic by `Tools/MKAFlightReplay` on any platform.
+ */
+@interface MKAFlightRecorder : NSObject
+/**
+ * Tells whether the events are recorded. Default is NO.
+ */
+@property (atomic, getter=isEnabled) BOOL enabled;
+/**
+ * The number of the latest events kept in the buffer.
+ */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/**
+ * Returns the recorder shared by all components.
+ */
++ (instancetype)sharedRecorder;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ * Writes the recorded events to given file. It can be called on any thread while the events are recorded.
+ *
+ * @return YES if the file is written, otherwise NO.
+ */
+- (BOOL)dumpToFile:(NSString *)path;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,86 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAFlightRecorder.h"
+
+#import "MKAFlightRecording.h"
+#import "MKAScheduler.h"
+
+/**
+ * The slots of the ring buffer. The number of them must be a power of two.
+ */
+static MKAFlightSlot _slots[4096];
+static MKAFlightRing _ring;
+
+void MKAFlightRecordEvent(const MKAFlightEvent *event) {
+    if (!atomic_load_explicit(&_ring.isEnabled, memory_order_relaxed)) {
+        return;
+    }
+
+    MKAFlightEvent stampedEvent = *event;
+    stampedEvent.time = MKASchedulerNow();
+    MKAFlightRingRecord(&_ring, &stampedEvent);
+}
+
+@implementation MKAFlightRecorder
+
++ (instancetype)sharedRecorder {
+    static MKAFlightRecorder *recorder = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        recorder = [[MKAFlightRecorder alloc] initPrivately];
+    });
+
+    return recorder;
+}
+
+- (instancetype)initPrivately {
+    if (self = [super init]) {
+        MKAFlightRingInit(&_ring, _slots, sizeof(_slots) / sizeof(_slots[0]));
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (BOOL)isEnabled {
+    return atomic_load_explicit(&_ring.isEnabled, memory_order_relaxed);
+}
+
+- (void)setEnabled:(BOOL)enabled {
+    MKAFlightRingSetEnabled(&_ring, enabled);
+}
+
+- (NSUInteger)capacity {
+    return _ring.capacity;
+}
+
+#pragma mark - public method
+
+- (BOOL)dumpToFile:(NSString *)path {
+    return MKAFlightRingWriteFile(&_ring, path.fileSystemRepresentation);
+}
+
+@end
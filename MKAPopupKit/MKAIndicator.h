@@ -24,17 +24,40 @@
 
 #import <UIKit/UIKit.h>
 
+#import "MKAQualityPolicy.h"
+
 NS_ASSUME_NONNULL_BEGIN
 
 typedef NS_ENUM(NSInteger, MKAIndicatorType) {
     MKAIndicatorTypeBasic = 0,
     MKAIndicatorTypeCustom,
     MKAIndicatorTypeSpriteAnimation,
+    MKAIndicatorTypeSpriteSheet,
+    MKAIndicatorTypeVector,
+    MKAIndicatorTypeProgress,
+};
+
+typedef NS_ENUM(NSInteger, MKAIndicatorProgressStyle) {
+    MKAIndicatorProgressStyleRing = 0,
+    MKAIndicatorProgressStyleBar,
 };
 
+/**
+ * A token returned by `-[MKAIndicator showTokenInView:ignoringUserInteraction:]` method.
+ * Pass it to `-[MKAIndicator hideToken:]` method to release its hold of the indicator.
+ * If the token is deallocated without being hidden, its hold is released automatically.
+ */
+@interface MKAIndicatorToken : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
 @interface MKAIndicator : NSObject
 /**
  * Returns YES if the indicator is displayed, otherwise NO.
+ * It is also YES while the indicator waits for the grace period.
  */
 @property (nonatomic, readonly) BOOL isVisible;
 /**
@@ -45,6 +68,27 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
  * The overlay's background color.
  */
 @property (nonatomic) UIColor *overlayColor;
+/**
+ * Returns YES if the indicator's images have been prepared by `-prepareWithCompletion:` method, otherwise NO.
+ */
+@property (nonatomic, readonly) BOOL isPrepared;
+/**
+ * A delay in seconds before the indicator is actually displayed. Default is 0.
+ */
+@property (nonatomic, readonly) NSTimeInterval gracePeriod;
+/**
+ * The minimum time in seconds that the indicator stays displayed once it appears. Default is 0.
+ */
+@property (nonatomic, readonly) NSTimeInterval minimumDisplayTime;
+/**
+ * The number of show requests that finished within the grace period, so no view was displayed.
+ */
+@property (nonatomic, readonly) NSUInteger skippedShowCount;
+/**
+ * The progress between 0 and 1 when `indicatorType` is MKAIndicatorTypeProgress. It is safe to set on any thread.
+ * Only the latest value is drawn on the main thread at most once per display frame, animating from the displayed value.
+ */
+@property (atomic) float progress;
 
 /**
  * Set given indicator as default indicator. You can get it using `+defaultIndicator` method.
@@ -57,6 +101,25 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
  * If you don't execute `+setDefaultIndicator:` method before executing this method, an exception occurs.
  */
 + (instancetype)defaultIndicator;
+/**
+ * Enables the disk cache of decoded images. Default is NO.
+ * The images loaded by name, that is, ones of `indicatorWithImageNamed:`, `indicatorWithImagesFormat:count:` and
+ * `indicatorWithStreamingImagesFormat:count:`, are stored as display-ready bitmaps when they are decoded.
+ * In later launches, they are memory-mapped from the cache without decoding.
+ *
+ * @param enabled YES if the disk cache is used.
+ */
++ (void)setDiskCacheEnabled:(BOOL)enabled;
+/**
+ * Sets the maximum total size in bytes of the disk cache. Least recently used bitmaps are removed when it is exceeded.
+ *
+ * @param limit The size in bytes. Default is 50 MB.
+ */
++ (void)setDiskCacheLimit:(NSUInteger)limit;
+/**
+ * Removes all bitmaps in the disk cache.
+ */
++ (void)removeDiskCache;
 /**
  * Returns new instance of basic style. Specify a UIActivityIndicatorViewStyle of the indicator.
  *
@@ -69,6 +132,13 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
  * @param image An image of an indicator.
  */
 + (instancetype)indicatorWithImage:(UIImage *)image;
+/**
+ * Returns new instance of custom style. Specify the name of the indicator's image.
+ * When the disk cache is enabled, the image prepared by `-prepareWithCompletion:` method is cached by the name.
+ *
+ * @param name The name of an image of an indicator.
+ */
++ (instancetype)indicatorWithImageNamed:(NSString *)name;
 /**
  * Returns new instance of sprite animation style.
  * Specify an array of indicator's images. The size of the indicator's image must be unified.
@@ -86,6 +156,68 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
  * @param count Number of frames.
  */
 + (instancetype)indicatorWithImagesFormat:(NSString *)format count:(NSInteger)count;
+/**
+ * Returns new instance of sprite animation style that decodes frames on demand.
+ * Only a few decoded frames are kept in memory and following frames are decoded in the background,
+ * so it is suitable for the animation having many or large frames.
+ * The frames with the same format are shared across indicators, and discarded when a memory warning is received.
+ *
+ * @param format A file name format like "indicator%ld". The file name must have a sequential number from 0.
+ * @param count Number of frames.
+ */
++ (instancetype)indicatorWithStreamingImagesFormat:(NSString *)format count:(NSInteger)count;
+/**
+ * Returns new instance of sprite animation style from an animated image like GIF or APNG.
+ * The frames are decoded incrementally from the container and only a few of them are kept in memory.
+ * The delay of each frame in the file is used, so `withAnimationDuration:` is ignored.
+ *
+ * @param data The data of an animated image.
+ */
++ (instancetype)indicatorWithAnimatedImageData:(NSData *)data;
+/**
+ * Returns new instance of sprite animation style from an animated image file like GIF or APNG.
+ * The frames are decoded incrementally from the file and only a few of them are kept in memory.
+ * The delay of each frame in the file is used, so `withAnimationDuration:` is ignored.
+ *
+ * @param url The file URL of an animated image.
+ */
++ (instancetype)indicatorWithAnimatedImageURL:(NSURL *)url;
+/**
+ * Returns new instance of sprite sheet style.
+ * Specify one image containing all frames arranged in a grid. Frames are ordered from left to right, top to bottom.
+ * The frames are switched by the render server, so the image is decoded and uploaded only once.
+ *
+ * @param image A sprite sheet image.
+ * @param columns Number of columns of the grid.
+ * @param rows Number of rows of the grid.
+ * @param count Number of frames. If it is 0, `columns * rows` is used.
+ */
++ (instancetype)indicatorWithSpriteSheet:(UIImage *)image
+                                 columns:(NSInteger)columns
+                                    rows:(NSInteger)rows
+                                   count:(NSInteger)count;
+/**
+ * Returns new instance of sprite sheet style.
+ * Specify one image containing all frames and the rectangle of each frame. The size of the frames must be unified.
+ *
+ * @param image A sprite sheet image.
+ * @param frameRects An array of the rectangles of frames in points of the image.
+ */
++ (instancetype)indicatorWithSpriteSheet:(UIImage *)image frameRects:(NSArray<NSValue *> *)frameRects;
+/**
+ * Returns new instance of vector style. The spinner is drawn with shape layers at any size and scale,
+ * so it uses no image memory.
+ *
+ * @param color A color of the arc.
+ * @param lineWidth A width of the arc in points.
+ */
++ (instancetype)indicatorWithStrokeColor:(UIColor *)color lineWidth:(CGFloat)lineWidth;
+/**
+ * Returns new instance of determinate progress style. Set `progress` property to update it.
+ *
+ * @param style A ring or a bar.
+ */
++ (instancetype)indicatorWithProgressStyle:(MKAIndicatorProgressStyle)style;
 
 - (void)startAnimating:(BOOL)animating inView:(UIView *)view withTouchDisabled:(BOOL)touchDisabled DEPRECATED_MSG_ATTRIBUTE(
     "Use `toggle:inView:ignoringUserInteraction:` method instead of this.");
@@ -122,12 +254,42 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
  * @param isUserInteractionDisabled If YES, the user can not operate while the indicator is displayed.
  */
 - (void)showInView:(UIView *)view atPoint:(CGPoint)point ignoringUserInteraction:(BOOL)isUserInteractionDisabled;
+/**
+ * Shows the indicator on the root view at center, and returns a token holding the indicator.
+ * It is safe to call from any thread. The indicator is shown on the main thread, and the calls in the same run loop turn
+ * are coalesced into one update. The indicator is hidden when all tokens are hidden or deallocated.
+ *
+ * @param isUserInteractionDisabled If YES, the user can not operate while the indicator is displayed.
+ * @return A token to pass to `hideToken:` method.
+ */
+- (MKAIndicatorToken *)showTokenIgnoringUserInteraction:(BOOL)isUserInteractionDisabled NS_SWIFT_NAME(showToken(ignoringUserInteraction:));
+/**
+ * Shows the indicator on specified view at center, and returns a token holding the indicator.
+ * It is safe to call from any thread. The indicator is shown on the main thread, and the calls in the same run loop turn
+ * are coalesced into one update. The indicator is hidden when all tokens are hidden or deallocated.
+ * While several tokens hold the indicator, it is shown with the view and the flag of the newest one,
+ * and it moves back to those of the previous token when the newest one is released.
+ *
+ * @param view Shows the indicator on specified view. If nil, the root view is used.
+ * @param isUserInteractionDisabled If YES, the user can not operate while the indicator is displayed.
+ * @return A token to pass to `hideToken:` method.
+ */
+- (MKAIndicatorToken *)showTokenInView:(nullable UIView *)view
+               ignoringUserInteraction:(BOOL)isUserInteractionDisabled NS_SWIFT_NAME(showToken(in:ignoringUserInteraction:));
+/**
+ * Releases the hold of given token. The second and later calls with the same token are ignored.
+ * It is safe to call from any thread.
+ *
+ * @param token A token returned by `showTokenInView:ignoringUserInteraction:` method.
+ */
+- (void)hideToken:(MKAIndicatorToken *)token;
 /**
  * Hides the indicator when the counter that counts displayed indicators is equal to 1.
  */
 - (void)hide;
 /**
  * Hides the indicator forcibly even if the counter that counts displayed indicators is greater than 1.
+ * Outstanding tokens are invalidated.
  */
 - (void)hideForcibly;
 /**
@@ -162,7 +324,7 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
 - (instancetype)withSize:(CGSize)size;
 - (instancetype)setSize:(CGSize)size DEPRECATED_MSG_ATTRIBUTE("Use `withSize:` method instead of this.");
 /**
- * Sets the animation speed when `indicatorType` is MKAIndicatorTypeCustom or MKAIndicatorTypeSpriteAnimation.
+ * Sets the animation speed when `indicatorType` is MKAIndicatorTypeCustom, MKAIndicatorTypeSpriteAnimation or MKAIndicatorTypeSpriteSheet.
  * You can not change the style while displaying.
  *
  * @param duration The animation speed (smaller value means faster).
@@ -170,19 +332,86 @@ typedef NS_ENUM(NSInteger, MKAIndicatorType) {
 - (instancetype)withAnimationDuration:(double)duration;
 - (instancetype)setAnimationDuration:(double)duration DEPRECATED_MSG_ATTRIBUTE("Use `withAnimationDuration:` method instead of this.");
 /**
- * Sets the number of animation's iterations when `indicatorType` is MKAIndicatorTypeCustom or MKAIndicatorTypeSpriteAnimation.
+ * Sets the number of animation's iterations when `indicatorType` is MKAIndicatorTypeCustom, MKAIndicatorTypeSpriteAnimation or MKAIndicatorTypeSpriteSheet.
  * You can not change the style while displaying.
  *
  * @param repeatCount The number of animation's iterations.
  */
 - (instancetype)withAnimationRepeatCount:(NSInteger)repeatCount;
 - (instancetype)setAnimationRepeatCount:(NSInteger)repeatCount DEPRECATED_MSG_ATTRIBUTE("Use `withAnimationRepeatCount:` method instead of this.");;
+/**
+ * Sets the maximum frame rate when `indicatorType` is MKAIndicatorTypeSpriteAnimation or MKAIndicatorTypeSpriteSheet.
+ * If the frames are more than the frame rate allows in the animation duration, some of them are skipped.
+ * 0 means no limit. You can not change the style while displaying.
+ *
+ * @param framesPerSecond The maximum number of frames displayed per second.
+ */
+- (instancetype)withFramesPerSecond:(NSInteger)framesPerSecond;
+/**
+ * Sets the delay before the indicator is actually displayed.
+ * If the indicator is hidden within the delay, no view is added, so short operations do not flicker the indicator.
+ *
+ * @param gracePeriod The delay in seconds, e.g. 0.15.
+ */
+- (instancetype)withGracePeriod:(NSTimeInterval)gracePeriod;
+/**
+ * Sets the minimum time that the indicator stays displayed once it appears.
+ * If the indicator is hidden earlier, it disappears when the time elapses.
+ *
+ * @param minimumDisplayTime The time in seconds.
+ */
+- (instancetype)withMinimumDisplayTime:(NSTimeInterval)minimumDisplayTime;
+/**
+ * Sets the scene where the indicator is shown by the methods without a view.
+ * If it is nil, the indicator is shown in the foreground active scene.
+ *
+ * @param scene The scene.
+ */
+- (instancetype)withWindowScene:(nullable UIWindowScene *)scene;
+/**
+ * Sets the quality level that limits the frame rate of the sprite animations.
+ * Default is `MKAQualityLevelAutomatic`, that follows the shared policy.
+ *
+ * @param level The quality level.
+ */
+- (instancetype)withQualityLevel:(MKAQualityLevel)level;
+/**
+ * Sets the color of the whole circle or bar drawn behind the arc
+ * when `indicatorType` is MKAIndicatorTypeVector or MKAIndicatorTypeProgress. Nothing is drawn if it is nil. You can not change the style while displaying.
+ *
+ * @param color The color.
+ */
+- (instancetype)withTrackColor:(nullable UIColor *)color;
+/**
+ * Sets the maximum length of the arc as a fraction of the circle when `indicatorType` is MKAIndicatorTypeVector.
+ * Default is 0.75. You can not change the style while displaying.
+ *
+ * @param arcLength The length between 0 and 1.
+ */
+- (instancetype)withArcLength:(CGFloat)arcLength;
+/**
+ * Shows the percentage of the progress when `indicatorType` is MKAIndicatorTypeProgress.
+ * Default is NO. You can not change the style while displaying.
+ *
+ * @param showsLabel YES if the label is shown.
+ */
+- (instancetype)withShowsProgressLabel:(BOOL)showsLabel;
 /**
  * Sets the overlay's background color.
  *
  * @param color The color.
  */
 - (instancetype)withOverlayColor:(UIColor *)color;
+/**
+ * Prepares the indicator's images for the display in the background.
+ * Each image is downsampled to the size set by `withSize:` method at the screen scale and decompressed,
+ * so that the first display does not stall the main thread. The prepared images are used when the indicator is shown.
+ * Execute this method after configuring the size.
+ *
+ * @param completion Called on the main thread when the preparation finishes.
+ *                   The argument is NO if the preparation was canceled because the indicator was changed.
+ */
+- (void)prepareWithCompletion:(nullable void (^)(BOOL isPrepared))completion;
 /**
  * Add the arbitrary background to the indicator.
  * The added background is set on the back. You can not change the style while displaying.
@@ -24,22 +24,129 @@
 
 #import "MKAIndicator.h"
 
+#import <objc/runtime.h>
+#import <stdatomic.h>
+
 #import "MKAActivityIndicatorViewWrapper.h"
+#import "MKAAnimationSuspender.h"
 #import "MKACustomIndicatorViewWrapper.h"
+#import "MKADecodedImageCache.h"
+#import "MKAFlightRecording.h"
 #import "MKAIndicatorInterface.h"
+#import "MKAIndicatorInternal.h"
+#import "MKALifecycle.h"
 #import "MKAPopupKitHelper.h"
+#import "MKAPresentationCoordinator.h"
+#import "MKAProgressIndicatorViewWrapper.h"
+#import "MKAScheduler.h"
 #import "MKASpriteAnimationIndicatorViewWrapper.h"
+#import "MKASpriteSheetIndicatorViewWrapper.h"
+#import "MKAVectorIndicatorViewWrapper.h"
 
-@interface MKAIndicator ()
+@interface MKAIndicator () <MKAAnimationSuspendable>
 
 @property (nonatomic) id <MKAIndicatorInterface> indicatorView;
-@property (nonatomic) NSUInteger count;
 @property (nonatomic) MKAIndicatorType indicatorType;
 @property (nonatomic, nullable) UIView *overlay;
+@property (nonatomic) BOOL isPrepared;
+/**
+ * Tells whether the indicator view is added to the view hierarchy.
+ */
+@property (nonatomic, readonly) BOOL isPresented;
+/**
+ * The timer of the scheduled work. It is canceled when the work is canceled or replaced.
+ */
+@property (nonatomic) MKAClockTimer workTimer;
+/**
+ * The view, the point and the flag to present the indicator with when the grace period elapses.
+ */
+@property (nonatomic, weak, nullable) UIView *pendingView;
+@property (nonatomic) CGPoint pendingPoint;
+@property (nonatomic) BOOL isPendingUserInteractionDisabled;
+/**
+ * The tokens holding the indicator from the oldest one. They are not retained: a token removes itself before it is
+ * deallocated. It is guarded by `@synchronized (self)`.
+ */
+@property (nonatomic) NSPointerArray *tokens;
+/**
+ * Incremented when outstanding tokens are invalidated. It is guarded by `@synchronized (self)`.
+ */
+@property (nonatomic) NSUInteger tokenGeneration;
+/**
+ * The view and the flag of the newest token that the indicator is shown with. They are changed on the main thread.
+ */
+@property (nonatomic, weak, nullable) UIView *tokenView;
+@property (nonatomic) BOOL isTokenUserInteractionDisabled;
+/**
+ * Tells whether the tokens hold the indicator on the main thread.
+ */
+@property (nonatomic) BOOL isTokenShowing;
+/**
+ * Tells whether the animation is paused because the indicator can not be seen.
+ */
+@property (nonatomic) BOOL isAnimationSuspended;
+@property (nonatomic, nullable) MKAWindowObserverView *windowObserver;
+/**
+ * The frame rate set by the user. The frame rate of the indicator view is limited further by the quality level.
+ */
+@property (nonatomic) NSInteger framesPerSecond;
+@property (nonatomic) MKAQualityLevel qualityLevel;
+@property (nonatomic, weak, nullable) UIWindowScene *windowScene;
+
+@end
+
+@interface MKAIndicatorToken ()
+
+@property (nonatomic, weak, nullable) MKAIndicator *indicator;
+@property (nonatomic) NSUInteger generation;
+/**
+ * The view and the flag given by the caller. The indicator is shown with them while the token is the newest one.
+ */
+@property (nonatomic, weak, nullable) UIView *view;
+@property (nonatomic) BOOL isUserInteractionDisabled;
 
 @end
 
-@implementation MKAIndicator
+@implementation MKAIndicatorToken {
+    atomic_bool _released;
+}
+
+- (instancetype)initWithIndicator:(MKAIndicator *)indicator
+                       generation:(NSUInteger)generation
+                             view:(nullable UIView *)view
+          ignoringUserInteraction:(BOOL)isUserInteractionDisabled {
+    if (self = [super init]) {
+        _indicator = indicator;
+        _generation = generation;
+        _view = view;
+        _isUserInteractionDisabled = isUserInteractionDisabled;
+        atomic_init(&_released, false);
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    // Releases the hold automatically when the token has not been hidden.
+    [_indicator hideToken:self];
+}
+
+/**
+ * Returns YES only for the first call.
+ */
+- (BOOL)markReleased {
+    return !atomic_exchange(&_released, true);
+}
+
+@end
+
+@implementation MKAIndicator {
+    atomic_bool _tokenFlushScheduled;
+    /**
+     * The counter, the grace period and the minimum display time. It is changed only on the main thread.
+     */
+    MKAIndicatorLifecycle _lifecycle;
+}
 
 static MKAIndicator *_defaultIndicator = nil;
 
@@ -63,6 +170,18 @@ static MKAIndicator *_defaultIndicator = nil;
     }
 }
 
++ (void)setDiskCacheEnabled:(BOOL)enabled {
+    [MKADecodedImageCache sharedCache].enabled = enabled;
+}
+
++ (void)setDiskCacheLimit:(NSUInteger)limit {
+    [MKADecodedImageCache sharedCache].limit = limit;
+}
+
++ (void)removeDiskCache {
+    [[MKADecodedImageCache sharedCache] removeAllImages];
+}
+
 + (instancetype)indicatorWithActivityIndicatorViewStyle:(UIActivityIndicatorViewStyle)style {
     MKAIndicator *indicator = [MKAIndicator new];
     indicator.indicatorType = MKAIndicatorTypeBasic;
@@ -79,6 +198,14 @@ static MKAIndicator *_defaultIndicator = nil;
     return indicator;
 }
 
++ (instancetype)indicatorWithImageNamed:(NSString *)name {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeCustom;
+    [((MKACustomIndicatorViewWrapper *) indicator.indicatorView) setImageNamed:name];
+
+    return indicator;
+}
+
 + (instancetype)indicatorWithImages:(NSArray<UIImage *> *)images {
     MKAIndicator *indicator = [MKAIndicator new];
     indicator.indicatorType = MKAIndicatorTypeSpriteAnimation;
@@ -95,11 +222,84 @@ static MKAIndicator *_defaultIndicator = nil;
     return indicator;
 }
 
++ (instancetype)indicatorWithStreamingImagesFormat:(NSString *)format count:(NSInteger)count {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeSpriteAnimation;
+    [((MKASpriteAnimationIndicatorViewWrapper *) indicator.indicatorView) setStreamingSpriteImagesWithFormat:format count:count];
+
+    return indicator;
+}
+
++ (instancetype)indicatorWithAnimatedImageData:(NSData *)data {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeSpriteAnimation;
+    [((MKASpriteAnimationIndicatorViewWrapper *) indicator.indicatorView) setStreamingAnimatedImageData:data];
+
+    return indicator;
+}
+
++ (instancetype)indicatorWithAnimatedImageURL:(NSURL *)url {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeSpriteAnimation;
+    [((MKASpriteAnimationIndicatorViewWrapper *) indicator.indicatorView) setStreamingAnimatedImageURL:url];
+
+    return indicator;
+}
+
++ (instancetype)indicatorWithSpriteSheet:(UIImage *)image
+                                 columns:(NSInteger)columns
+                                    rows:(NSInteger)rows
+                                   count:(NSInteger)count {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeSpriteSheet;
+    [((MKASpriteSheetIndicatorViewWrapper *) indicator.indicatorView) setSpriteSheet:image
+                                                                             columns:columns
+                                                                                rows:rows
+                                                                               count:count];
+
+    return indicator;
+}
+
++ (instancetype)indicatorWithSpriteSheet:(UIImage *)image frameRects:(NSArray<NSValue *> *)frameRects {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeSpriteSheet;
+    [((MKASpriteSheetIndicatorViewWrapper *) indicator.indicatorView) setSpriteSheet:image frameRects:frameRects];
+
+    return indicator;
+}
+
++ (instancetype)indicatorWithStrokeColor:(UIColor *)color lineWidth:(CGFloat)lineWidth {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeVector;
+    MKAVectorIndicatorViewWrapper *wrapper = (MKAVectorIndicatorViewWrapper *) indicator.indicatorView;
+    wrapper.strokeColor = color;
+    wrapper.lineWidth = lineWidth;
+
+    return indicator;
+}
+
++ (instancetype)indicatorWithProgressStyle:(MKAIndicatorProgressStyle)style {
+    MKAIndicator *indicator = [MKAIndicator new];
+    indicator.indicatorType = MKAIndicatorTypeProgress;
+    ((MKAProgressIndicatorViewWrapper *) indicator.indicatorView).style = style;
+
+    return indicator;
+}
+
 - (instancetype)init {
     if (self = [super init]) {
         _indicatorView = [MKAActivityIndicatorViewWrapper new];
         _indicatorType = MKAIndicatorTypeBasic;
         _overlayColor = [UIColor.blackColor colorWithAlphaComponent:0.05];
+        _tokens = [NSPointerArray pointerArrayWithOptions:NSPointerFunctionsOpaqueMemory | NSPointerFunctionsOpaquePersonality];
+        _qualityLevel = MKAQualityLevelAutomatic;
+        MKAIndicatorLifecycleInit(&_lifecycle);
+        atomic_init(&_tokenFlushScheduled, false);
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(qualityLevelDidChange:)
+                                                     name:MKAQualityPolicyLevelDidChangeNotification
+                                                   object:nil];
     }
 
     return self;
@@ -108,7 +308,36 @@ static MKAIndicator *_defaultIndicator = nil;
 #pragma mark - property
 
 - (BOOL)isVisible {
-    return self.count > 0;
+    return _lifecycle.count > 0;
+}
+
+- (BOOL)isPresented {
+    return MKAIndicatorLifecycleIsPresented(&_lifecycle);
+}
+
+- (NSTimeInterval)gracePeriod {
+    return _lifecycle.gracePeriod;
+}
+
+- (NSTimeInterval)minimumDisplayTime {
+    return _lifecycle.minimumDisplayTime;
+}
+
+- (NSUInteger)skippedShowCount {
+    return _lifecycle.skippedShowCount;
+}
+
+- (float)progress {
+    id <MKAIndicatorInterface> indicatorView = self.indicatorView;
+    return [indicatorView isKindOfClass:MKAProgressIndicatorViewWrapper.class] ? ((MKAProgressIndicatorViewWrapper *) indicatorView).progress : 0;
+}
+
+- (void)setProgress:(float)progress {
+    id <MKAIndicatorInterface> indicatorView = self.indicatorView;
+
+    if ([indicatorView isKindOfClass:MKAProgressIndicatorViewWrapper.class]) {
+        [((MKAProgressIndicatorViewWrapper *) indicatorView) setProgress:progress];
+    }
 }
 
 - (void)setIndicatorType:(MKAIndicatorType)indicatorType {
@@ -120,9 +349,20 @@ static MKAIndicator *_defaultIndicator = nil;
     else if (indicatorType == MKAIndicatorTypeSpriteAnimation) {
         _indicatorView = [MKASpriteAnimationIndicatorViewWrapper new];
     }
+    else if (indicatorType == MKAIndicatorTypeSpriteSheet) {
+        _indicatorView = [MKASpriteSheetIndicatorViewWrapper new];
+    }
+    else if (indicatorType == MKAIndicatorTypeVector) {
+        _indicatorView = [MKAVectorIndicatorViewWrapper new];
+    }
+    else if (indicatorType == MKAIndicatorTypeProgress) {
+        _indicatorView = [MKAProgressIndicatorViewWrapper new];
+    }
     else {
         _indicatorView = [MKAActivityIndicatorViewWrapper new];
     }
+
+    _isPrepared = NO;
 }
 
 #pragma mark - public method
@@ -154,25 +394,18 @@ static MKAIndicator *_defaultIndicator = nil;
 }
 
 - (void)showInView:(UIView *)view atPoint:(CGPoint)point withTouchDisabled:(BOOL)touchDisabled {
-    ++self.count;
-
-    if (self.count == 1) {
-        self.indicatorView.view.center = point;
-
-        [view addSubview:self.indicatorView.view];
-        [view bringSubviewToFront:self.indicatorView.view];
-
-        [self.indicatorView startAnimating];
-
-        if (touchDisabled && ![UIApplication sharedApplication].isIgnoringInteractionEvents) {
-            // Disables user touch events.
-            [[UIApplication sharedApplication] beginIgnoringInteractionEvents];
-        }
-    }
+    [self showInView:view atPoint:point ignoringUserInteraction:touchDisabled];
 }
 
 - (void)showIgnoringUserInteraction:(BOOL)isUserInteractionDisabled {
-    UIView *view = [MKAPopupKitHelper rootView];
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self showIgnoringUserInteraction:isUserInteractionDisabled];
+        });
+        return;
+    }
+
+    UIView *view = [MKAPopupKitHelper rootViewInScene:self.windowScene];
     [self showInView:view ignoringUserInteraction:isUserInteractionDisabled];
 }
 
@@ -181,69 +414,185 @@ static MKAIndicator *_defaultIndicator = nil;
 }
 
 - (void)showInView:(UIView *)view atPoint:(CGPoint)point ignoringUserInteraction:(BOOL)isUserInteractionDisabled {
-    ++self.count;
-
-    if (self.count == 1) {
-        if (isUserInteractionDisabled && !self.overlay) {
-            // Adds the overlay view for preventing user interaction events.
-            self.overlay = [[UIView alloc] initWithFrame:view.bounds];
-            self.overlay.backgroundColor = self.overlayColor;
-            [self.overlay setUserInteractionEnabled:YES];
-            [view addSubview:self.overlay];
-        }
-
-        self.indicatorView.view.center = point;
-
-        [view addSubview:self.indicatorView.view];
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self showInView:view atPoint:point ignoringUserInteraction:isUserInteractionDisabled];
+        });
+        return;
+    }
 
-        [self.indicatorView startAnimating];
+    double delay = 0;
+
+    const MKAIndicatorAction action = [self recordAction:MKAIndicatorLifecycleShow(&_lifecycle, MKASchedulerNow(), YES, &delay)
+                                                  ofType:MKAFlightEventTypeIndicatorShow
+                                                   flags:1];
+
+    switch (action) {
+        case MKAIndicatorActionCancelScheduled:
+            // Keeps displaying the indicator waiting for the minimum display time.
+            [self cancelScheduledWork];
+            break;
+        case MKAIndicatorActionSchedulePresent: {
+            // Does nothing with views until the grace period elapses. The target may be changed by the tokens till then.
+            self.pendingView = view;
+            self.pendingPoint = point;
+            self.isPendingUserInteractionDisabled = isUserInteractionDisabled;
+
+            __weak typeof(self) weakSelf = self;
+            [self scheduleWork:^{
+                typeof(self) strongSelf = weakSelf;
+
+                if (!strongSelf) {
+                    return;
+                }
+
+                UIView *targetView = strongSelf.pendingView;
+
+                if (!targetView) {
+                    // The view has been deallocated in the grace period. Resets the lifecycle, which is still pending.
+                    [strongSelf hideForcibly];
+                    return;
+                }
+
+                const MKAIndicatorAction elapsedAction = MKAIndicatorLifecycleGracePeriodElapsed(&strongSelf->_lifecycle, MKASchedulerNow());
+
+                if ([strongSelf recordAction:elapsedAction ofType:MKAFlightEventTypeIndicatorGracePeriodElapsed flags:0] == MKAIndicatorActionPresent) {
+                    [strongSelf presentInView:targetView
+                                      atPoint:strongSelf.pendingPoint
+                      ignoringUserInteraction:strongSelf.isPendingUserInteractionDisabled];
+                }
+            }
+                         after:delay];
+            break;
+        }
+        case MKAIndicatorActionPresent:
+            [self presentInView:view atPoint:point ignoringUserInteraction:isUserInteractionDisabled];
+            break;
+        default:
+            break;
     }
 }
 
 - (void)hide {
-    if (!self.isVisible) {
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self hide];
+        });
         return;
     }
 
-    --self.count;
+    double delay = 0;
+
+    const MKAIndicatorAction action = [self recordAction:MKAIndicatorLifecycleHide(&_lifecycle, MKASchedulerNow(), &delay)
+                                                  ofType:MKAFlightEventTypeIndicatorHide
+                                                   flags:0];
+
+    switch (action) {
+        case MKAIndicatorActionCancelScheduled:
+            // Finished within the grace period.
+            [self cancelScheduledWork];
+            [self notifyHidden];
+            break;
+        case MKAIndicatorActionScheduleDismiss: {
+            __weak typeof(self) weakSelf = self;
+            [self scheduleWork:^{
+                typeof(self) strongSelf = weakSelf;
+
+                if (!strongSelf) {
+                    return;
+                }
+
+                const MKAIndicatorAction elapsedAction = MKAIndicatorLifecycleMinimumDisplayTimeElapsed(&strongSelf->_lifecycle);
+
+                if ([strongSelf recordAction:elapsedAction ofType:MKAFlightEventTypeIndicatorMinimumDisplayTimeElapsed flags:0] == MKAIndicatorActionDismiss) {
+                    [strongSelf dismiss];
+                }
+            }
+                         after:delay];
+            break;
+        }
+        case MKAIndicatorActionDismiss:
+            [self dismiss];
+            break;
+        default:
+            break;
+    }
+}
+
+- (void)hideForcibly {
+    if (![NSThread isMainThread]) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self hideForcibly];
+        });
+        return;
+    }
 
-    if (self.count == 0) {
-        [self.indicatorView stopAnimating];
+    @synchronized (self) {
+        self.tokens.count = 0;
+        ++self.tokenGeneration;
+    }
+    self.isTokenShowing = NO;
+    self.tokenView = nil;
 
-        [self.indicatorView.view removeFromSuperview];
+    [self cancelScheduledWork];
 
-        [self.overlay removeFromSuperview];
-        self.overlay = nil;
+    const MKAIndicatorAction action = [self recordAction:MKAIndicatorLifecycleHideForcibly(&_lifecycle)
+                                                  ofType:MKAFlightEventTypeIndicatorHideForcibly
+                                                   flags:0];
 
-        if ([UIApplication sharedApplication].isIgnoringInteractionEvents) {
-            // Enables user touch events.
-            [[UIApplication sharedApplication] endIgnoringInteractionEvents];
-        }
+    if (action == MKAIndicatorActionDismiss) {
+        [self dismiss];
+    }
+    else if (action == MKAIndicatorActionCancelScheduled) {
+        [self notifyHidden];
     }
 }
 
-- (void)hideForcibly {
-    if (!self.isVisible) {
-        return;
+- (MKAIndicatorToken *)showTokenIgnoringUserInteraction:(BOOL)isUserInteractionDisabled {
+    return [self showTokenInView:nil ignoringUserInteraction:isUserInteractionDisabled];
+}
+
+- (MKAIndicatorToken *)showTokenInView:(nullable UIView *)view ignoringUserInteraction:(BOOL)isUserInteractionDisabled {
+    MKAIndicatorToken *token;
+
+    @synchronized (self) {
+        token = [[MKAIndicatorToken alloc] initWithIndicator:self
+                                                  generation:self.tokenGeneration
+                                                        view:view
+                                     ignoringUserInteraction:isUserInteractionDisabled];
+        [self.tokens addPointer:(__bridge void *) token];
     }
 
-    self.count = 0;
+    [self scheduleTokenFlush];
 
-    [self.indicatorView stopAnimating];
+    return token;
+}
 
-    [self.indicatorView.view removeFromSuperview];
+- (void)hideToken:(MKAIndicatorToken *)token {
+    if (![token markReleased]) {
+        return;
+    }
 
-    [self.overlay removeFromSuperview];
-    self.overlay = nil;
+    @synchronized (self) {
+        // The token was invalidated by `hideForcibly`.
+        if (token.generation != self.tokenGeneration) {
+            return;
+        }
 
-    if ([UIApplication sharedApplication].isIgnoringInteractionEvents) {
-        // Enables user touch events.
-        [[UIApplication sharedApplication] endIgnoringInteractionEvents];
+        // Usually the newest token is released first.
+        for (NSUInteger i = self.tokens.count; i > 0; i--) {
+            if ([self.tokens pointerAtIndex:i - 1] == (__bridge void *) token) {
+                [self.tokens removePointerAtIndex:i - 1];
+                break;
+            }
+        }
     }
+
+    [self scheduleTokenFlush];
 }
 
 - (void)toggle:(BOOL)show ignoringUserInteraction:(BOOL)isUserInteractionDisabled {
-    UIView *view = [MKAPopupKitHelper rootView];
+    UIView *view = [MKAPopupKitHelper rootViewInScene:self.windowScene];
     [self toggle:show inView:view ignoringUserInteraction:isUserInteractionDisabled];
 }
 
@@ -267,6 +616,12 @@ static MKAIndicator *_defaultIndicator = nil;
 
     self.indicatorView.view.bounds = (CGRect) { CGPointZero, size };
 
+    // The prepared images no longer fit the size.
+    if (self.isPrepared && [self.indicatorView respondsToSelector:@selector(setPreparedImages:)]) {
+        [self.indicatorView setPreparedImages:nil];
+    }
+    self.isPrepared = NO;
+
     return self;
 }
 
@@ -285,6 +640,12 @@ static MKAIndicator *_defaultIndicator = nil;
     else if (self.indicatorType == MKAIndicatorTypeSpriteAnimation) {
         ((MKASpriteAnimationIndicatorViewWrapper *) self.indicatorView).duration = duration;
     }
+    else if (self.indicatorType == MKAIndicatorTypeSpriteSheet) {
+        ((MKASpriteSheetIndicatorViewWrapper *) self.indicatorView).duration = duration;
+    }
+    else if (self.indicatorType == MKAIndicatorTypeVector) {
+        ((MKAVectorIndicatorViewWrapper *) self.indicatorView).duration = duration;
+    }
 
     return self;
 }
@@ -304,6 +665,12 @@ static MKAIndicator *_defaultIndicator = nil;
     else if (self.indicatorType == MKAIndicatorTypeSpriteAnimation) {
         ((MKASpriteAnimationIndicatorViewWrapper *) self.indicatorView).repeatCount = repeatCount;
     }
+    else if (self.indicatorType == MKAIndicatorTypeSpriteSheet) {
+        ((MKASpriteSheetIndicatorViewWrapper *) self.indicatorView).repeatCount = repeatCount;
+    }
+    else if (self.indicatorType == MKAIndicatorTypeVector) {
+        ((MKAVectorIndicatorViewWrapper *) self.indicatorView).repeatCount = repeatCount;
+    }
 
     return self;
 }
@@ -312,11 +679,127 @@ static MKAIndicator *_defaultIndicator = nil;
     return [self withAnimationRepeatCount:repeatCount];
 }
 
+- (instancetype)withFramesPerSecond:(NSInteger)framesPerSecond {
+    if (self.isVisible) {
+        return self;
+    }
+
+    self.framesPerSecond = framesPerSecond;
+
+    return self;
+}
+
+- (instancetype)withGracePeriod:(NSTimeInterval)gracePeriod {
+    _lifecycle.gracePeriod = MAX(gracePeriod, 0);
+    return self;
+}
+
+- (instancetype)withMinimumDisplayTime:(NSTimeInterval)minimumDisplayTime {
+    _lifecycle.minimumDisplayTime = MAX(minimumDisplayTime, 0);
+    return self;
+}
+
+- (instancetype)withWindowScene:(nullable UIWindowScene *)scene {
+    self.windowScene = scene;
+    return self;
+}
+
+- (instancetype)withQualityLevel:(MKAQualityLevel)level {
+    self.qualityLevel = level;
+    return self;
+}
+
+- (instancetype)withTrackColor:(nullable UIColor *)color {
+    if (self.isVisible) {
+        return self;
+    }
+
+    if (self.indicatorType == MKAIndicatorTypeVector) {
+        ((MKAVectorIndicatorViewWrapper *) self.indicatorView).trackColor = color;
+    }
+    else if (self.indicatorType == MKAIndicatorTypeProgress) {
+        ((MKAProgressIndicatorViewWrapper *) self.indicatorView).trackColor = color;
+    }
+
+    return self;
+}
+
+- (instancetype)withArcLength:(CGFloat)arcLength {
+    if (self.isVisible || self.indicatorType != MKAIndicatorTypeVector) {
+        return self;
+    }
+
+    ((MKAVectorIndicatorViewWrapper *) self.indicatorView).arcLength = arcLength;
+
+    return self;
+}
+
+- (instancetype)withShowsProgressLabel:(BOOL)showsLabel {
+    if (self.isVisible || self.indicatorType != MKAIndicatorTypeProgress) {
+        return self;
+    }
+
+    ((MKAProgressIndicatorViewWrapper *) self.indicatorView).showsLabel = showsLabel;
+
+    return self;
+}
+
 - (instancetype)withOverlayColor:(UIColor *)color {
     self.overlayColor = color;
     return self;
 }
 
+- (void)prepareWithCompletion:(nullable void (^)(BOOL isPrepared))completion {
+    id <MKAIndicatorInterface> indicatorView = self.indicatorView;
+    NSArray<UIImage *> *images = [indicatorView respondsToSelector:@selector(sourceImages)] ? [indicatorView sourceImages] : @[];
+
+    if (images.count == 0) {
+        // Nothing to prepare.
+        self.isPrepared = YES;
+
+        if (completion) {
+            completion(YES);
+        }
+
+        return;
+    }
+
+    NSArray<NSString *> *names = [indicatorView respondsToSelector:@selector(sourceImageNames)] ? [indicatorView sourceImageNames] : @[];
+    const CGSize size = indicatorView.view.bounds.size;
+    const CGFloat scale = [UIScreen mainScreen].scale;
+    __weak typeof(self) weakSelf = self;
+
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        MKADecodedImageCache *cache = [MKADecodedImageCache sharedCache];
+        NSMutableArray<UIImage *> *preparedImages = [NSMutableArray arrayWithCapacity:images.count];
+
+        [images enumerateObjectsUsingBlock:^(UIImage *image, NSUInteger idx, BOOL *stop) {
+            NSString *name = idx < names.count ? names[idx] : nil;
+            [preparedImages addObject:[cache decodedImage:image name:name size:size scale:scale] ?: image];
+        }];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            MKAIndicator *indicator = weakSelf;
+
+            // Discards the result when the indicator has been changed while preparing.
+            if (!indicator || indicator.indicatorView != indicatorView || !CGSizeEqualToSize(indicatorView.view.bounds.size, size)) {
+                if (completion) {
+                    completion(NO);
+                }
+
+                return;
+            }
+
+            [indicatorView setPreparedImages:preparedImages];
+            indicator.isPrepared = YES;
+
+            if (completion) {
+                completion(YES);
+            }
+        });
+    });
+}
+
 - (instancetype)addBackgroundView:(UIView *)bgView {
     if (self.isVisible) {
         return self;
@@ -342,4 +825,270 @@ static MKAIndicator *_defaultIndicator = nil;
     return [self addBackgroundView:bgView];
 }
 
+#pragma mark - private method
+
+- (void)presentInView:(UIView *)view atPoint:(CGPoint)point ignoringUserInteraction:(BOOL)isUserInteractionDisabled {
+    MKAPresentationCoordinator *coordinator = [MKAPresentationCoordinator sharedCoordinator];
+
+    // Places the indicator shown on the whole screen in the indicator layer above popups.
+    if (view == [MKAPopupKitHelper rootViewInScene:self.windowScene]) {
+        view = [coordinator viewForLayer:MKAPresentationLayerIndicator inScene:self.windowScene];
+    }
+
+    if (isUserInteractionDisabled && !self.overlay) {
+        // Adds the overlay view for preventing user interaction events. It is reused for the same view.
+        UIView *overlay = [self overlayForView:view];
+        overlay.frame = view.bounds;
+        overlay.backgroundColor = self.overlayColor;
+        [coordinator presentView:overlay inView:view layer:MKAPresentationLayerIndicator];
+        self.overlay = overlay;
+    }
+
+    self.indicatorView.view.center = point;
+
+    [coordinator presentView:self.indicatorView.view inView:view layer:MKAPresentationLayerIndicator];
+
+    [self applyFramesPerSecond];
+    [self.indicatorView startAnimating];
+
+    // Watches the window of the indicator view to pause the animation while the host view is off-window.
+    if (!self.windowObserver) {
+        self.windowObserver = [MKAWindowObserverView new];
+    }
+    if (self.windowObserver.superview != self.indicatorView.view) {
+        [self.indicatorView.view addSubview:self.windowObserver];
+    }
+
+    [[MKAAnimationSuspender sharedSuspender] addSuspendable:self];
+}
+
+- (void)dismiss {
+    [[MKAAnimationSuspender sharedSuspender] removeSuspendable:self];
+    [self setAnimationSuspended:NO];
+
+    [self.indicatorView stopAnimating];
+
+    [[MKAPresentationCoordinator sharedCoordinator] dismissView:self.indicatorView.view];
+
+    if (self.overlay) {
+        [[MKAPresentationCoordinator sharedCoordinator] dismissView:self.overlay];
+        self.overlay = nil;
+    }
+
+    [self notifyHidden];
+}
+
+- (void)notifyHidden {
+    // Keeps the handler alive while it runs, since it may clear the property.
+    void (^hiddenHandler)(MKAIndicator *) = self.hiddenHandler;
+
+    if (hiddenHandler) {
+        hiddenHandler(self);
+    }
+}
+
+/**
+ * Returns the overlay reused for given view. It is associated with the view, so it is released with the view.
+ */
+- (UIView *)overlayForView:(UIView *)view {
+    UIView *overlay = objc_getAssociatedObject(view, (__bridge const void *) self);
+
+    if (!overlay) {
+        overlay = [UIView new];
+        // Follows the size of the view while it is displayed.
+        overlay.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        overlay.userInteractionEnabled = YES;
+        objc_setAssociatedObject(view, (__bridge const void *) self, overlay, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+
+    return overlay;
+}
+
+/**
+ * Sets the frame rate limited by the quality level to the sprite indicator view.
+ */
+- (void)applyFramesPerSecond {
+    NSInteger limit = 0;
+
+    switch ([[MKAQualityPolicy sharedPolicy] levelForComponentLevel:self.qualityLevel]) {
+        case MKAQualityLevelReduced:
+            limit = 30;
+            break;
+        case MKAQualityLevelMinimal:
+            limit = 15;
+            break;
+        default:
+            break;
+    }
+
+    const NSInteger framesPerSecond = self.framesPerSecond > 0 && limit > 0 ? MIN(self.framesPerSecond, limit) : MAX(self.framesPerSecond, limit);
+
+    if (self.indicatorType == MKAIndicatorTypeSpriteAnimation) {
+        ((MKASpriteAnimationIndicatorViewWrapper *) self.indicatorView).framesPerSecond = framesPerSecond;
+    }
+    else if (self.indicatorType == MKAIndicatorTypeSpriteSheet) {
+        ((MKASpriteSheetIndicatorViewWrapper *) self.indicatorView).framesPerSecond = framesPerSecond;
+    }
+}
+
+- (void)qualityLevelDidChange:(NSNotification *)notification {
+    if (!self.isPresented || self.qualityLevel != MKAQualityLevelAutomatic) {
+        return;
+    }
+    if (self.indicatorType != MKAIndicatorTypeSpriteAnimation && self.indicatorType != MKAIndicatorTypeSpriteSheet) {
+        return;
+    }
+
+    [self applyFramesPerSecond];
+
+    if (self.isAnimationSuspended) {
+        return;
+    }
+
+    // Restarts the sprite animation at the new frame rate.
+    [self.indicatorView stopAnimating];
+    [self.indicatorView startAnimating];
+}
+
+/**
+ * Records given action returned by the lifecycle with the counter after it.
+ */
+- (MKAIndicatorAction)recordAction:(MKAIndicatorAction)action ofType:(MKAFlightEventType)type flags:(uint8_t)flags {
+    MKAFlightRecordEvent(&(MKAFlightEvent) {
+        .object = MKAFlightObject(self),
+        .value = _lifecycle.gracePeriod,
+        .secondValue = _lifecycle.minimumDisplayTime,
+        .count = (uint32_t) _lifecycle.count,
+        .type = (uint16_t) type,
+        .result = (uint8_t) action,
+        .flags = flags,
+    });
+
+    return action;
+}
+
+/**
+ * Executes given work after the delay on the scheduler's clock unless it is canceled.
+ * Only the last scheduled work is valid.
+ */
+- (void)scheduleWork:(dispatch_block_t)work after:(NSTimeInterval)delay {
+    MKASchedulerCancel(self.workTimer);
+
+    __weak typeof(self) weakSelf = self;
+
+    self.workTimer = MKASchedulerSchedule(delay, ^{
+        weakSelf.workTimer = 0;
+        work();
+    });
+}
+
+- (void)cancelScheduledWork {
+    MKASchedulerCancel(self.workTimer);
+    self.workTimer = 0;
+}
+
+/**
+ * Applies the token count on the main thread once per run loop turn however many times it is changed.
+ */
+- (void)scheduleTokenFlush {
+    if (atomic_exchange(&_tokenFlushScheduled, true)) {
+        return;
+    }
+
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self flushTokens];
+    });
+}
+
+- (void)flushTokens {
+    atomic_store(&_tokenFlushScheduled, false);
+
+    NSUInteger tokenCount;
+    UIView *view = nil;
+    BOOL isUserInteractionDisabled = NO;
+
+    @synchronized (self) {
+        tokenCount = self.tokens.count;
+
+        if (tokenCount > 0) {
+            // Not retained, since the token may be waiting for the lock in its dealloc.
+            __unsafe_unretained MKAIndicatorToken *newestToken = (__bridge MKAIndicatorToken *) [self.tokens pointerAtIndex:tokenCount - 1];
+            view = newestToken.view;
+            isUserInteractionDisabled = newestToken.isUserInteractionDisabled;
+        }
+    }
+
+    if (tokenCount > 0 && !self.isTokenShowing) {
+        self.isTokenShowing = YES;
+        self.tokenView = view;
+        self.isTokenUserInteractionDisabled = isUserInteractionDisabled;
+        // All tokens share one hold of the counter.
+        [self showInView:view ?: [MKAPopupKitHelper rootViewInScene:self.windowScene] ignoringUserInteraction:isUserInteractionDisabled];
+    }
+    else if (tokenCount == 0 && self.isTokenShowing) {
+        self.isTokenShowing = NO;
+        self.tokenView = nil;
+        [self hide];
+    }
+    else if (tokenCount > 0 && (view != self.tokenView || isUserInteractionDisabled != self.isTokenUserInteractionDisabled)) {
+        // The newest token has been shown or released. Follows the newest one of the rest.
+        self.tokenView = view;
+        self.isTokenUserInteractionDisabled = isUserInteractionDisabled;
+        [self moveToView:view ?: [MKAPopupKitHelper rootViewInScene:self.windowScene] ignoringUserInteraction:isUserInteractionDisabled];
+    }
+}
+
+/**
+ * Moves the indicator waiting for the grace period or displayed to given view.
+ */
+- (void)moveToView:(UIView *)view ignoringUserInteraction:(BOOL)isUserInteractionDisabled {
+    switch (_lifecycle.state) {
+        case MKAIndicatorStatePending:
+            self.pendingView = view;
+            self.pendingPoint = view.center;
+            self.isPendingUserInteractionDisabled = isUserInteractionDisabled;
+            break;
+        case MKAIndicatorStatePresented:
+        case MKAIndicatorStateLingering:
+            if (self.overlay) {
+                [[MKAPresentationCoordinator sharedCoordinator] dismissView:self.overlay];
+                self.overlay = nil;
+            }
+
+            [self presentInView:view atPoint:view.center ignoringUserInteraction:isUserInteractionDisabled];
+            break;
+        default:
+            break;
+    }
+}
+
+#pragma mark - MKAAnimationSuspendable
+
+- (nullable UIView *)suspendableView {
+    return self.isPresented ? self.indicatorView.view : nil;
+}
+
+- (void)setAnimationSuspended:(BOOL)suspended {
+    if (self.isAnimationSuspended == suspended) {
+        return;
+    }
+
+    self.isAnimationSuspended = suspended;
+
+    if (suspended) {
+        [MKAPopupKitHelper pauseLayer:self.indicatorView.view.layer];
+
+        if ([self.indicatorView respondsToSelector:@selector(pauseAnimating)]) {
+            [self.indicatorView pauseAnimating];
+        }
+    }
+    else {
+        [MKAPopupKitHelper resumeLayer:self.indicatorView.view.layer];
+
+        if ([self.indicatorView respondsToSelector:@selector(resumeAnimating)]) {
+            [self.indicatorView resumeAnimating];
+        }
+    }
+}
+
 @end
@@ -0,0 +1,95 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+@class MKAIndicator;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * MKAIndicatorRegistry shows an indicator on each of many views, e.g. table view cells or cards.
+ * The indicators are taken from the pool and bound to the views with weak references.
+ * When a view is deallocated, its indicator returns to the pool automatically.
+ * Use the indicator types animated by the render server (basic, custom and sprite sheet),
+ * then hundreds of indicators run without any timer or work per frame on the main thread.
+ */
+@interface MKAIndicatorRegistry : NSObject
+/**
+ * The maximum number of indicators kept in the pool for reuse. Default is 32.
+ */
+@property (nonatomic) NSUInteger maximumPoolSize;
+/**
+ * The number of indicators bound to views.
+ */
+@property (nonatomic, readonly) NSUInteger activeCount;
+/**
+ * The number of indicators waiting in the pool.
+ */
+@property (nonatomic, readonly) NSUInteger pooledCount;
+
+/**
+ * Returns the shared registry creating basic type indicators.
+ */
++ (instancetype)sharedRegistry;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ * Creates a registry creating indicators by given block when the pool is empty.
+ *
+ * @param factory A block that returns new indicator.
+ */
+- (instancetype)initWithFactory:(MKAIndicator *(^)(void))factory NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Returns the indicator bound to given view, or nil if none is bound.
+ */
+- (nullable MKAIndicator *)indicatorForView:(UIView *)view;
+/**
+ * Shows the indicator at the center of given view. The counter of the view's indicator is incremented by 1.
+ */
+- (void)showInView:(UIView *)view;
+/**
+ * Hides the indicator of given view when its counter is equal to 1. The indicator returns to the pool when it becomes
+ * hidden, that is after the minimum display time if it is displayed, or at once if it waits for the grace period.
+ */
+- (void)hideInView:(UIView *)view;
+/**
+ * Shows the indicators on given views in one transaction.
+ */
+- (void)showInViews:(NSArray<UIView *> *)views;
+/**
+ * Hides the indicators of given views in one transaction.
+ */
+- (void)hideInViews:(NSArray<UIView *> *)views;
+/**
+ * Hides all indicators forcibly in one transaction.
+ */
+- (void)hideAll;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,260 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAIndicatorRegistry.h"
+
+#import <objc/runtime.h>
+
+#import "MKAIndicator.h"
+#import "MKAIndicatorInternal.h"
+
+@class MKAIndicatorRegistryEntry;
+
+@interface MKAIndicatorRegistry ()
+
+@property (nonatomic, copy) MKAIndicator *(^factory)(void);
+@property (nonatomic) NSMutableArray<MKAIndicator *> *pool;
+@property (nonatomic) NSHashTable<UIView *> *views;
+
+- (void)reclaimIndicator:(MKAIndicator *)indicator;
+
+@end
+
+/**
+ * Binds an indicator to a view as an associated object. It is released together with the view.
+ */
+@interface MKAIndicatorRegistryEntry : NSObject
+
+@property (nonatomic, weak, nullable) MKAIndicatorRegistry *registry;
+@property (nonatomic, nullable) MKAIndicator *indicator;
+
+@end
+
+@implementation MKAIndicatorRegistryEntry
+
+- (void)dealloc {
+    MKAIndicatorRegistry *registry = _registry;
+    MKAIndicator *indicator = _indicator;
+
+    if (!registry || !indicator) {
+        return;
+    }
+
+    // The view has been deallocated, so the indicator can not finish hiding in it. Returns it to the pool.
+    if ([NSThread isMainThread]) {
+        [registry reclaimIndicator:indicator];
+    }
+    else {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [registry reclaimIndicator:indicator];
+        });
+    }
+}
+
+@end
+
+@implementation MKAIndicatorRegistry
+
++ (instancetype)sharedRegistry {
+    static MKAIndicatorRegistry *registry = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        registry = [[MKAIndicatorRegistry alloc] initWithFactory:^MKAIndicator * {
+            return [MKAIndicator indicatorWithActivityIndicatorViewStyle:UIActivityIndicatorViewStyleMedium];
+        }];
+    });
+
+    return registry;
+}
+
+- (instancetype)initWithFactory:(MKAIndicator *(^)(void))factory {
+    if (self = [super init]) {
+        _factory = [factory copy];
+        _maximumPoolSize = 32;
+        _pool = [NSMutableArray array];
+        _views = [NSHashTable weakObjectsHashTable];
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (NSUInteger)activeCount {
+    return self.views.allObjects.count;
+}
+
+- (NSUInteger)pooledCount {
+    return self.pool.count;
+}
+
+#pragma mark - public method
+
+- (nullable MKAIndicator *)indicatorForView:(UIView *)view {
+    return [self entryForView:view].indicator;
+}
+
+- (void)showInView:(UIView *)view {
+    MKAIndicatorRegistryEntry *entry = [self entryForView:view];
+
+    if (!entry) {
+        entry = [MKAIndicatorRegistryEntry new];
+        entry.registry = self;
+        entry.indicator = [self dequeueIndicator];
+        [self observeIndicator:entry.indicator inView:view];
+        objc_setAssociatedObject(view, (__bridge const void *) self, entry, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        [self.views addObject:view];
+    }
+
+    [entry.indicator showInView:view
+                        atPoint:CGPointMake(CGRectGetMidX(view.bounds), CGRectGetMidY(view.bounds))
+        ignoringUserInteraction:NO];
+}
+
+- (void)hideInView:(UIView *)view {
+    MKAIndicatorRegistryEntry *entry = [self entryForView:view];
+    MKAIndicator *indicator = entry.indicator;
+
+    if (!indicator) {
+        return;
+    }
+
+    // The indicator returns to the pool when it becomes hidden, which is after the minimum display time if it lingers.
+    [indicator hide];
+}
+
+- (void)showInViews:(NSArray<UIView *> *)views {
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+
+    for (UIView *view in views) {
+        [self showInView:view];
+    }
+
+    [CATransaction commit];
+}
+
+- (void)hideInViews:(NSArray<UIView *> *)views {
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+
+    for (UIView *view in views) {
+        [self hideInView:view];
+    }
+
+    [CATransaction commit];
+}
+
+- (void)hideAll {
+    [CATransaction begin];
+    [CATransaction setDisableActions:YES];
+
+    for (UIView *view in self.views.allObjects) {
+        MKAIndicatorRegistryEntry *entry = [self entryForView:view];
+
+        // The indicator returns to the pool when it becomes hidden.
+        [entry.indicator hideForcibly];
+
+        if (entry.indicator) {
+            [self unbindEntry:entry fromView:view];
+        }
+    }
+
+    [CATransaction commit];
+}
+
+#pragma mark - private method
+
+- (nullable MKAIndicatorRegistryEntry *)entryForView:(UIView *)view {
+    return objc_getAssociatedObject(view, (__bridge const void *) self);
+}
+
+- (MKAIndicator *)dequeueIndicator {
+    MKAIndicator *indicator = self.pool.lastObject;
+
+    if (indicator) {
+        [self.pool removeLastObject];
+        return indicator;
+    }
+
+    return self.factory();
+}
+
+/**
+ * Unbinds the indicator from the view once it becomes hidden in the view.
+ */
+- (void)observeIndicator:(MKAIndicator *)indicator inView:(UIView *)view {
+    __weak typeof(self) weakSelf = self;
+    __weak UIView *weakView = view;
+
+    indicator.hiddenHandler = ^(MKAIndicator *hiddenIndicator) {
+        typeof(self) strongSelf = weakSelf;
+        UIView *hostView = weakView;
+
+        if (!strongSelf || !hostView) {
+            return;
+        }
+
+        MKAIndicatorRegistryEntry *entry = [strongSelf entryForView:hostView];
+
+        if (entry.indicator == hiddenIndicator) {
+            [strongSelf unbindEntry:entry fromView:hostView];
+        }
+    };
+}
+
+- (void)unbindEntry:(MKAIndicatorRegistryEntry *)entry fromView:(UIView *)view {
+    MKAIndicator *indicator = entry.indicator;
+
+    // Prevents the entry from recycling the indicator again when it is released.
+    entry.indicator = nil;
+    objc_setAssociatedObject(view, (__bridge const void *) self, nil, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    [self.views removeObject:view];
+
+    if (indicator) {
+        [self recycleIndicator:indicator];
+    }
+}
+
+/**
+ * Returns the hidden indicator to the pool.
+ */
+- (void)recycleIndicator:(MKAIndicator *)indicator {
+    indicator.hiddenHandler = nil;
+
+    if (self.pool.count < self.maximumPoolSize) {
+        [self.pool addObject:indicator];
+    }
+}
+
+/**
+ * Returns the indicator of a deallocated view to the pool, detaching its view immediately.
+ */
+- (void)reclaimIndicator:(MKAIndicator *)indicator {
+    indicator.hiddenHandler = nil;
+    [indicator hideForcibly];
+    [self recycleIndicator:indicator];
+}
+
+@end
@@ -26,6 +26,8 @@
 
 #import <UIKit/UIKit.h>
 
+#import "MKAQualityPolicy.h"
+
 NS_ASSUME_NONNULL_BEGIN
 
 @protocol MKAPopupDelegate;
@@ -88,6 +90,19 @@ typedef NS_ENUM(NSInteger, MKAPopupViewAnimation) {
  * An animation duration.
  */
 @property (nonatomic) NSTimeInterval duration;
+/**
+ * A scene where the popup is shown. If it is nil, the popup is shown in the foreground active scene.
+ */
+@property (nonatomic, weak, nullable) UIWindowScene *windowScene;
+/**
+ * A quality level of the animations. Default is `MKAQualityLevelAutomatic`, that follows the shared policy.
+ */
+@property (nonatomic) MKAQualityLevel qualityLevel;
+/**
+ * A time until a popup is hidden automatically after it appears. If it is zero or less, the popup is not hidden
+ * automatically. Default is 0.
+ */
+@property (nonatomic) NSTimeInterval autoDismissTime;
 /**
  * Returns YES if a popup is shown, otherwise NO.
  */
@@ -122,6 +137,14 @@ typedef NS_ENUM(NSInteger, MKAPopupViewAnimation) {
  * @param duration An animation duration.
  */
 - (void)showWithAnimation:(MKAPopupViewAnimation)animation duration:(NSTimeInterval)duration;
+/**
+ * Shows a popup using the set animation type and duration after given delay.
+ * Showing or hiding the popup before the delay elapses cancels it.
+ * The popup is not retained while waiting, so keep a reference to it.
+ *
+ * @param delay A delay until the popup is shown.
+ */
+- (void)showAfterDelay:(NSTimeInterval)delay;
 /**
  * Hides a popup using the set animation type and duration.
  */
@@ -26,7 +26,14 @@
 
 #import "MKAPopup.h"
 
+#import "MKAAnimationSuspender.h"
+#import "MKAFlightRecording.h"
+#import "MKALifecycle.h"
 #import "MKAPopupKitHelper.h"
+#import "MKAPopupSubclass.h"
+#import "MKAPresentationCoordinator.h"
+#import "MKARenderer.h"
+#import "MKAScheduler.h"
 
 @implementation MKAPopupLabel
 
@@ -60,13 +67,15 @@
 
 - (void)beginShowingAnimation:(MKAPopupViewAnimation)animation
                      rootView:(UIView *)rootView;
-- (void)showWithAnimation:(MKAPopupViewAnimation)animation
-                 duration:(NSTimeInterval)duration
-               completion:(nullable void (^)(BOOL finished))completion;
-- (void)hideWithAnimation:(MKAPopupViewAnimation)animation
-                 duration:(NSTimeInterval)duration
-               completion:(nullable void (^)(BOOL finished))completion
-                 rootView:(UIView *)rootView;
+/**
+ * Sets the final values of the showing animation. Call it in the animation block.
+ */
+- (void)finishShowingAnimation:(MKAPopupViewAnimation)animation;
+/**
+ * Sets the final values of the hiding animation. Call it in the animation block.
+ */
+- (void)finishHidingAnimation:(MKAPopupViewAnimation)animation
+                     rootView:(UIView *)rootView;
 
 @end
 
@@ -100,12 +109,10 @@
         self.titleLabel.bounds = CGRectZero;
     }
 
-    self.titleLabel.center = CGPointMake(self.frame.size.width / 2.f, self.titleLabel.frame.size.height / 2.f);
-    self.containerView.frame = CGRectMake(0,
-                                          CGRectGetMaxY(self.titleLabel.frame),
-                                          self.frame.size.width,
-                                          self.frame.size.height - CGRectGetMaxY(self.titleLabel.frame));
-
+    MKAPopupViewLayout layout = MKALayoutPopupView(MKALayoutSizeFromCGSize(self.bounds.size),
+                                                   MKALayoutSizeFromCGSize(self.titleLabel.bounds.size));
+    MKARendererSetFrame(self.titleLabel, CGRectFromMKALayoutRect(layout.titleFrame));
+    MKARendererSetFrame(self.containerView, CGRectFromMKALayoutRect(layout.containerFrame));
 }
 
 - (void)beginShowingAnimation:(MKAPopupViewAnimation)animation
@@ -131,76 +138,52 @@
     }
 }
 
-- (void)showWithAnimation:(MKAPopupViewAnimation)animation
-                 duration:(NSTimeInterval)duration
-               completion:(nullable void (^)(BOOL finished))completion {
-
-    __weak typeof(self) weakSelf = self;
-
-    [UIView animateWithDuration:duration
-                     animations:^{
-                         switch (animation) {
-                             case MKAPopupViewAnimationFade:
-                                 weakSelf.alpha = 1.f;
-                                 break;
-                             case MKAPopupViewAnimationSlideUp:
-                             case MKAPopupViewAnimationSlideDown:
-                             case MKAPopupViewAnimationSlideLeft:
-                             case MKAPopupViewAnimationSlideRight:
-                                 weakSelf.transform = CGAffineTransformMakeTranslation(0, 0);
-                                 break;
-                             default:
-                                 break;
-                         }
-                     }
-                     completion:completion];
-}
-
-- (void)hideWithAnimation:(MKAPopupViewAnimation)animation
-                 duration:(NSTimeInterval)duration
-               completion:(nullable void (^)(BOOL finished))completion
-                 rootView:(UIView *)rootView {
-
-    __weak typeof(self) weakSelf = self;
-
-    [UIView animateWithDuration:duration
-                     animations:^{
-                         switch (animation) {
-                             case MKAPopupViewAnimationFade:
-                                 weakSelf.alpha = 0;
-                                 break;
-                             case MKAPopupViewAnimationSlideUp:
-                                 weakSelf.transform = CGAffineTransformMakeTranslation(0,
-                                                                                       -rootView.bounds.size.height);
-                                 break;
-                             case MKAPopupViewAnimationSlideDown:
-                                 weakSelf.transform = CGAffineTransformMakeTranslation(0,
-                                                                                       rootView.bounds.size.height);
-                                 break;
-                             case MKAPopupViewAnimationSlideLeft:
-                                 weakSelf.transform = CGAffineTransformMakeTranslation(-rootView.bounds.size.width,
-                                                                                       0);
-                                 break;
-                             case MKAPopupViewAnimationSlideRight:
-                                 weakSelf.transform = CGAffineTransformMakeTranslation(rootView.bounds.size.width,
-                                                                                       0);
-                                 break;
-                             default:
-                                 break;
-                         }
-                     }
-                     completion:completion];
+- (void)finishShowingAnimation:(MKAPopupViewAnimation)animation {
+    switch (animation) {
+        case MKAPopupViewAnimationFade:
+            self.alpha = 1.f;
+            break;
+        case MKAPopupViewAnimationSlideUp:
+        case MKAPopupViewAnimationSlideDown:
+        case MKAPopupViewAnimationSlideLeft:
+        case MKAPopupViewAnimationSlideRight:
+            self.transform = CGAffineTransformMakeTranslation(0, 0);
+            break;
+        default:
+            break;
+    }
 }
 
-@end
-
-@interface MKAPopup ()
-
-@property (nonatomic) BOOL isShowing;
+- (void)finishHidingAnimation:(MKAPopupViewAnimation)animation
+                     rootView:(UIView *)rootView {
+    switch (animation) {
+        case MKAPopupViewAnimationFade:
+            self.alpha = 0;
+            break;
+        case MKAPopupViewAnimationSlideUp:
+            self.transform = CGAffineTransformMakeTranslation(0, -rootView.bounds.size.height);
+            break;
+        case MKAPopupViewAnimationSlideDown:
+            self.transform = CGAffineTransformMakeTranslation(0, rootView.bounds.size.height);
+            break;
+        case MKAPopupViewAnimationSlideLeft:
+            self.transform = CGAffineTransformMakeTranslation(-rootView.bounds.size.width, 0);
+            break;
+        case MKAPopupViewAnimationSlideRight:
+            self.transform = CGAffineTransformMakeTranslation(rootView.bounds.size.width, 0);
+            break;
+        default:
+            break;
+    }
+}
 
 @end
 
-@implementation MKAPopup
+@implementation MKAPopup {
+    MKAPopupPresentation _presentation;
+    MKAClockTimer _showTimer;
+    MKAClockTimer _autoDismissTimer;
+}
 
 - (instancetype)initWithFrame:(CGRect)frame {
     @throw [NSException exceptionWithName:NSInternalInconsistencyException
@@ -216,16 +199,22 @@
 
 - (instancetype)initWithContentView:(UIView *)contentView {
     if (self = [super initWithFrame:CGRectZero]) {
-        self.translatesAutoresizingMaskIntoConstraints = NO;
+        // Follows the size of the root view without constraints.
+        self.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
         self.backgroundColor = [[UIColor blackColor] colorWithAlphaComponent:.4f];
         _canHideWhenTouchUpOutside = YES;
         _showingAnimation = MKAPopupViewAnimationFade;
         _hidingAnimation = MKAPopupViewAnimationFade;
         _duration = 0.3;
+        _qualityLevel = MKAQualityLevelAutomatic;
 
         _popupView = [MKAPopupView new];
         _popupView.frame = CGRectMake(0, 0, 320.f, 480.f);
         [self addSubview:_popupView];
+        MKAPopupPresentationInit(&_presentation,
+                                 (__bridge MKARenderNode) self,
+                                 (__bridge MKARenderNode) _popupView,
+                                 MKAPopupPlacementCenter);
 
         [_popupView.containerView addSubview:contentView];
         contentView.translatesAutoresizingMaskIntoConstraints = NO;
@@ -243,7 +232,11 @@
 - (void)layoutSubviews {
     [super layoutSubviews];
 
-    self.popupView.center = CGPointMake(self.frame.size.width / 2.f, self.frame.size.height / 2.f);
+    _presentation.popupSize = MKALayoutSizeFromCGSize(self.popupView.bounds.size);
+    MKAPopupPresentationLayout(&_presentation,
+                               MKARendererCurrentBackend(),
+                               MKALayoutSizeFromCGSize(self.bounds.size),
+                               MKALayoutInsetsZero);
 }
 
 - (void)touchesEnded:(NSSet<UITouch *> *)touches withEvent:(nullable UIEvent *)event {
@@ -261,7 +254,16 @@
 }
 
 - (BOOL)isShowing {
-    return self.superview != nil;
+    return _presentation.state != MKAPopupStateHidden;
+}
+
+- (MKAPopupPlacement)placement {
+    return _presentation.placement;
+}
+
+- (void)setPlacement:(MKAPopupPlacement)placement {
+    _presentation.placement = placement;
+    [self setNeedsLayout];
 }
 
 - (CGSize)popupSize {
@@ -269,10 +271,11 @@
 }
 
 - (void)setPopupSize:(CGSize)popupSize {
-    CGSize screenSize = [MKAPopupKitHelper rootView].bounds.size;
-    CGFloat width = MIN(popupSize.width, screenSize.width);
-    CGFloat height = MIN(popupSize.height, screenSize.height);
-    self.popupView.bounds = (CGRect) { { 0, 0 }, { width, height } };
+    CGSize screenSize = [MKAPopupKitHelper rootViewInScene:self.windowScene].bounds.size;
+    MKALayoutSize size = MKALayoutClampPopupSize(MKALayoutSizeFromCGSize(popupSize),
+                                                 MKALayoutSizeFromCGSize(screenSize),
+                                                 MKALayoutInsetsZero);
+    self.popupView.bounds = (CGRect) { CGPointZero, CGSizeFromMKALayoutSize(size) };
 }
 
 #pragma mark - public method
@@ -286,7 +289,10 @@
 }
 
 - (void)showWithAnimation:(MKAPopupViewAnimation)animation duration:(NSTimeInterval)duration {
-    if (self.isShowing) {
+    [self cancelShowTimer];
+
+    if (!MKAPopupStateCanHandle(_presentation.state, MKAPopupEventShow)) {
+        [self recordEvent:MKAPopupEventShow isAccepted:NO];
         return;
     }
 
@@ -294,33 +300,67 @@
         [self.delegate popupWillAppear:self];
     }
 
-    UIView *rootView = [MKAPopupKitHelper rootView];
+    UIView *rootView = [[MKAPresentationCoordinator sharedCoordinator] viewForLayer:MKAPresentationLayerPopup
+                                                                            inScene:self.windowScene];
+
+    animation = [self animationForQualityLevel:animation];
+    duration = [self durationForQualityLevel:duration];
 
     // Resets states for showing animation.
     self.alpha = 0;
     [self.popupView beginShowingAnimation:animation rootView:rootView];
 
-    [rootView addSubview:self];
-    [NSLayoutConstraint activateConstraints:@[
-        [self.topAnchor constraintEqualToAnchor:rootView.topAnchor],
-        [self.leftAnchor constraintEqualToAnchor:rootView.leftAnchor],
-        [self.bottomAnchor constraintEqualToAnchor:rootView.bottomAnchor],
-        [self.rightAnchor constraintEqualToAnchor:rootView.rightAnchor],
-    ]];
+    // Inserts, lays out and begins one animation of the background and the popup view.
+    _presentation.popupSize = MKALayoutSizeFromCGSize(self.popupView.bounds.size);
+    MKAPopupPresentationShow(&_presentation,
+                             MKARendererCurrentBackend(),
+                             (__bridge MKARenderNode) rootView,
+                             MKALayoutSizeFromCGSize(rootView.bounds.size),
+                             MKALayoutInsetsZero,
+                             duration);
+    [self recordEvent:MKAPopupEventShow isAccepted:YES];
+    [[MKAPresentationCoordinator sharedCoordinator] registerView:self inView:rootView layer:MKAPresentationLayerPopup];
 
     __weak typeof(self) weakSelf = self;
 
-    // Starts showing animation.
-    [UIView animateWithDuration:.3 animations:^{
+    [UIView animateWithDuration:duration animations:^{
         weakSelf.alpha = 1.0;
+        [weakSelf.popupView finishShowingAnimation:animation];
     }];
-    [self.popupView showWithAnimation:animation
-                             duration:duration
-                           completion:^(BOOL finished) {
-                               if ([weakSelf.delegate respondsToSelector:@selector(popupDidAppear:)]) {
-                                   [weakSelf.delegate popupDidAppear:weakSelf];
-                               }
-                           }];
+
+    // The completion is scheduled on the clock instead of the animation, so the popup follows a virtual time.
+    MKASchedulerSchedule(duration, ^{
+        typeof(self) strongSelf = weakSelf;
+
+        if (!strongSelf) {
+            return;
+        }
+
+        // Does nothing when the popup started hiding during the animation.
+        if (![strongSelf recordEvent:MKAPopupEventShowFinished
+                          isAccepted:MKAPopupPresentationShowFinished(&strongSelf->_presentation)]) {
+            return;
+        }
+
+        // Pauses the animations covered by the popup when its background is opaque.
+        [[MKAAnimationSuspender sharedSuspender] addOccluder:strongSelf];
+        [strongSelf startAutoDismissTimer];
+        MKAFlightRecord(MKAFlightEventTypePopupDidAppear, strongSelf, 0, 0);
+
+        if ([strongSelf.delegate respondsToSelector:@selector(popupDidAppear:)]) {
+            [strongSelf.delegate popupDidAppear:strongSelf];
+        }
+    });
+}
+
+- (void)showAfterDelay:(NSTimeInterval)delay {
+    [self cancelShowTimer];
+
+    __weak typeof(self) weakSelf = self;
+
+    _showTimer = MKASchedulerSchedule(delay, ^{
+        [weakSelf show];
+    });
 }
 
 - (void)hide {
@@ -332,7 +372,12 @@
 }
 
 - (void)hideWithAnimation:(MKAPopupViewAnimation)animation duration:(NSTimeInterval)duration {
-    if (!self.isShowing) {
+    [self cancelShowTimer];
+    MKASchedulerCancel(_autoDismissTimer);
+    _autoDismissTimer = 0;
+
+    if (!MKAPopupStateCanHandle(_presentation.state, MKAPopupEventHide)) {
+        [self recordEvent:MKAPopupEventHide isAccepted:NO];
         return;
     }
 
@@ -340,22 +385,90 @@
         [self.delegate popupWillDisappear:self];
     }
 
+    // Resumes the covered animations before they are revealed.
+    [[MKAAnimationSuspender sharedSuspender] removeOccluder:self];
+
+    animation = [self animationForQualityLevel:animation];
+    duration = [self durationForQualityLevel:duration];
+
+    MKAPopupPresentationHide(&_presentation, MKARendererCurrentBackend(), duration);
+    [self recordEvent:MKAPopupEventHide isAccepted:YES];
+
     __weak typeof(self) weakSelf = self;
 
-    [UIView animateWithDuration:.3 animations:^{
+    [UIView animateWithDuration:duration animations:^{
         weakSelf.alpha = 0;
+        [weakSelf.popupView finishHidingAnimation:animation rootView:weakSelf];
     }];
 
-    [self.popupView hideWithAnimation:animation
-                             duration:duration
-                           completion:^(BOOL finished) {
-                               [weakSelf removeFromSuperview];
+    MKASchedulerSchedule(duration, ^{
+        typeof(self) strongSelf = weakSelf;
+
+        if (!strongSelf) {
+            return;
+        }
+
+        if (![strongSelf recordEvent:MKAPopupEventHideFinished
+                          isAccepted:MKAPopupPresentationHideFinished(&strongSelf->_presentation,
+                                                                      MKARendererCurrentBackend())]) {
+            return;
+        }
+
+        [[MKAPresentationCoordinator sharedCoordinator] unregisterView:strongSelf];
+        MKAFlightRecord(MKAFlightEventTypePopupDidDisappear, strongSelf, 0, 0);
+
+        if ([strongSelf.delegate respondsToSelector:@selector(popupDidDisappear:)]) {
+            [strongSelf.delegate popupDidDisappear:strongSelf];
+        }
+    });
+}
+
+#pragma mark - private method
+
+/**
+ * Records given event applied to the presentation.
+ *
+ * @return isAccepted
+ */
+- (BOOL)recordEvent:(MKAPopupEvent)event isAccepted:(BOOL)isAccepted {
+    MKAFlightRecord((MKAFlightEventType) (MKAFlightEventTypePopupShow + event), self, isAccepted, 0);
+    return isAccepted;
+}
+
+- (void)cancelShowTimer {
+    MKASchedulerCancel(_showTimer);
+    _showTimer = 0;
+}
+
+- (void)startAutoDismissTimer {
+    if (self.autoDismissTime <= 0) {
+        return;
+    }
+
+    __weak typeof(self) weakSelf = self;
+
+    _autoDismissTimer = MKASchedulerSchedule(self.autoDismissTime, ^{
+        [weakSelf hide];
+    });
+}
+
+/**
+ * Replaces the slide animations with the fade at the reduced level and all animations with none at the minimal level.
+ */
+- (MKAPopupViewAnimation)animationForQualityLevel:(MKAPopupViewAnimation)animation {
+    switch ([[MKAQualityPolicy sharedPolicy] levelForComponentLevel:self.qualityLevel]) {
+        case MKAQualityLevelReduced:
+            return animation == MKAPopupViewAnimationNone ? animation : MKAPopupViewAnimationFade;
+        case MKAQualityLevelMinimal:
+            return MKAPopupViewAnimationNone;
+        default:
+            return animation;
+    }
+}
 
-                               if ([weakSelf.delegate respondsToSelector:@selector(popupDidDisappear:)]) {
-                                   [weakSelf.delegate popupDidDisappear:weakSelf];
-                               }
-                           }
-                             rootView:self];
+- (NSTimeInterval)durationForQualityLevel:(NSTimeInterval)duration {
+    const MKAQualityLevel level = [[MKAQualityPolicy sharedPolicy] levelForComponentLevel:self.qualityLevel];
+    return level == MKAQualityLevelMinimal ? 0 : duration;
 }
 
 @end
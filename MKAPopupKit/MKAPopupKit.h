@@ -35,6 +35,10 @@ FOUNDATION_EXPORT const unsigned char MKAPopupKitVersionString[];
 // In this header, you should import all the public headers of your framework using statements like #import <MKAPopupKit/PublicHeader.h>
 
 #import "MKABottomSheet.h"
+#import "MKAFlightRecorder.h"
 #import "MKAIndicator.h"
+#import "MKAIndicatorRegistry.h"
 #import "MKAPopup.h"
+#import "MKAPresentationCoordinator.h"
+#import "MKAQualityPolicy.h"
 #import "MKAToast.h"
@@ -0,0 +1,114 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The layers where presented views are placed. A view in an upper layer is always above the views in lower layers.
+ */
+typedef NS_ENUM(NSInteger, MKAPresentationLayer) {
+    MKAPresentationLayerBackdrop = 0,
+    MKAPresentationLayerPopup,
+    MKAPresentationLayerIndicator,
+    MKAPresentationLayerToast,
+};
+
+/**
+ * A view presented by the coordinator.
+ */
+@interface MKAPresentationRecord : NSObject
+
+@property (nonatomic, readonly) MKAPresentationLayer layer;
+@property (nonatomic, weak, readonly, nullable) UIView *view;
+/**
+ * The view where the view is added. It is a layer of the coordinator unless the view is presented in a specific view.
+ */
+@property (nonatomic, weak, readonly, nullable) UIView *hostView;
+/**
+ * The time when the view was presented in the media time, or in the virtual time if the clock is replaced.
+ */
+@property (nonatomic, readonly) CFTimeInterval presentedTime;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+@end
+
+/**
+ * MKAPresentationCoordinator adds and removes all views of MKAPopup, MKABottomSheet, MKAToast and MKAIndicator.
+ * Each window has one container with a view for each layer, so a view is inserted by appending it to its layer
+ * and the order of the layers never changes. The container passes touches through outside the presented views.
+ * All methods must be called on the main thread.
+ */
+@interface MKAPresentationCoordinator : NSObject
+
++ (instancetype)sharedCoordinator;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ * Presents the views of given scene in given window instead of the key window of the scene, e.g. a window of a higher
+ * level or an external display. If the scene is nil, the window is used for the views presented without a scene.
+ * The window is not retained. Setting nil restores the lookup of the key window.
+ */
+- (void)setWindow:(nullable UIWindow *)window forScene:(nullable UIWindowScene *)scene;
+/**
+ * Returns the view of given layer in given scene. If the scene is nil, the foreground active scene is used.
+ */
+- (UIView *)viewForLayer:(MKAPresentationLayer)layer inScene:(nullable UIWindowScene *)scene;
+/**
+ * Adds given view to the top of given layer in given scene.
+ *
+ * @return The view of the layer.
+ */
+- (UIView *)presentView:(UIView *)view inLayer:(MKAPresentationLayer)layer scene:(nullable UIWindowScene *)scene;
+/**
+ * Adds given view to the top of given host view, recording it as a view of given layer.
+ */
+- (void)presentView:(UIView *)view inView:(UIView *)hostView layer:(MKAPresentationLayer)layer;
+/**
+ * Removes given view from its superview.
+ */
+- (void)dismissView:(UIView *)view;
+/**
+ * Records given view that has been added to given host view through the render backend, as a view of given layer.
+ * A view has one record while it is alive, which is reset on every presentation.
+ */
+- (void)registerView:(UIView *)view inView:(UIView *)hostView layer:(MKAPresentationLayer)layer;
+/**
+ * Marks given view that has been removed through the render backend as not presented. Its record is kept for the next
+ * presentation.
+ */
+- (void)unregisterView:(UIView *)view;
+/**
+ * Returns the presented views ordered from the bottom layer to the top one, and in the order of presentation in each layer.
+ */
+- (NSArray<MKAPresentationRecord *> *)snapshot;
+
+@end
+
+NS_ASSUME_NONNULL_END
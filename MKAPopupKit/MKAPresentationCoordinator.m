@@ -0,0 +1,244 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAPresentationCoordinator.h"
+
+#import <objc/runtime.h>
+
+#import "MKAPopupKitHelper.h"
+#import "MKARenderer.h"
+#import "MKAScheduler.h"
+#import "MKAWindowResolver.h"
+
+static const NSInteger kLayerCount = MKAPresentationLayerToast + 1;
+
+@interface MKAPresentationRecord ()
+
+@property (nonatomic) MKAPresentationLayer layer;
+@property (nonatomic, weak, nullable) UIView *view;
+@property (nonatomic, weak, nullable) UIView *hostView;
+@property (nonatomic) CFTimeInterval presentedTime;
+/**
+ * The order of presentation.
+ */
+@property (nonatomic) NSUInteger sequence;
+
+@end
+
+@implementation MKAPresentationRecord
+
+- (instancetype)initWithView:(UIView *)view {
+    if (self = [super init]) {
+        _view = view;
+    }
+
+    return self;
+}
+
+/**
+ * Records a new presentation of the view, so a view presented again reuses its record.
+ */
+- (void)resetWithHostView:(UIView *)hostView layer:(MKAPresentationLayer)layer sequence:(NSUInteger)sequence {
+    self.hostView = hostView;
+    self.layer = layer;
+    self.sequence = sequence;
+    self.presentedTime = MKASchedulerNow();
+}
+
+- (NSString *)description {
+    static NSString *const names[] = { @"backdrop", @"popup", @"indicator", @"toast" };
+    UIView *view = self.view;
+
+    return [NSString stringWithFormat:@"<%@: layer=%@ view=<%@: %p> frame=%@ host=%p>",
+                                      NSStringFromClass(self.class),
+                                      names[self.layer],
+                                      NSStringFromClass(view.class),
+                                      view,
+                                      NSStringFromCGRect(view.frame),
+                                      self.hostView];
+}
+
+@end
+
+/**
+ * A view that does not receive touches by itself, so only its subviews do.
+ */
+@interface MKAPassThroughView : UIView
+
+@end
+
+@implementation MKAPassThroughView
+
+- (nullable UIView *)hitTest:(CGPoint)point withEvent:(nullable UIEvent *)event {
+    UIView *view = [super hitTest:point withEvent:event];
+    return view == self ? nil : view;
+}
+
+@end
+
+@interface MKAPresentationCoordinator ()
+
+/**
+ * The container of each window. Its subviews are the views of the layers in order.
+ */
+@property (nonatomic) NSMapTable<UIWindow *, UIView *> *containers;
+/**
+ * The records of the views presented once at least. Each record is associated with its view, so it is kept while
+ * the view is alive, and its host view is nil while the view is not presented.
+ */
+@property (nonatomic) NSHashTable<MKAPresentationRecord *> *records;
+@property (nonatomic) NSUInteger sequence;
+
+@end
+
+@implementation MKAPresentationCoordinator
+
++ (instancetype)sharedCoordinator {
+    static MKAPresentationCoordinator *coordinator = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        coordinator = [[MKAPresentationCoordinator alloc] initPrivately];
+    });
+
+    return coordinator;
+}
+
+- (instancetype)initPrivately {
+    if (self = [super init]) {
+        _containers = [NSMapTable weakToStrongObjectsMapTable];
+        _records = [NSHashTable weakObjectsHashTable];
+    }
+
+    return self;
+}
+
+#pragma mark - public method
+
+- (void)setWindow:(nullable UIWindow *)window forScene:(nullable UIWindowScene *)scene {
+    [[MKAWindowResolver sharedResolver] setWindow:window forScene:scene];
+}
+
+- (UIView *)viewForLayer:(MKAPresentationLayer)layer inScene:(nullable UIWindowScene *)scene {
+    UIView *rootView = [MKAPopupKitHelper rootViewInScene:scene];
+    UIView *container = [self containerForWindow:rootView.window];
+
+    if (container.superview != rootView) {
+        container.frame = rootView.bounds;
+        [rootView addSubview:container];
+    }
+    else if (rootView.subviews.lastObject != container) {
+        // Another view has been added to the root view after the container.
+        [rootView bringSubviewToFront:container];
+    }
+
+    return container.subviews[(NSUInteger) layer];
+}
+
+- (UIView *)presentView:(UIView *)view inLayer:(MKAPresentationLayer)layer scene:(nullable UIWindowScene *)scene {
+    UIView *layerView = [self viewForLayer:layer inScene:scene];
+    [self presentView:view inView:layerView layer:layer];
+
+    return layerView;
+}
+
+- (void)presentView:(UIView *)view inView:(UIView *)hostView layer:(MKAPresentationLayer)layer {
+    MKARendererInsertView(view, hostView);
+    [self registerView:view inView:hostView layer:layer];
+}
+
+- (void)dismissView:(UIView *)view {
+    MKARendererRemoveView(view);
+    [self unregisterView:view];
+}
+
+- (void)registerView:(UIView *)view inView:(UIView *)hostView layer:(MKAPresentationLayer)layer {
+    MKAPresentationRecord *record = [self recordForView:view];
+
+    if (!record) {
+        record = [[MKAPresentationRecord alloc] initWithView:view];
+        objc_setAssociatedObject(view, (__bridge const void *) self, record, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        [self.records addObject:record];
+    }
+
+    [record resetWithHostView:hostView layer:layer sequence:++self.sequence];
+}
+
+- (void)unregisterView:(UIView *)view {
+    [self recordForView:view].hostView = nil;
+}
+
+- (NSArray<MKAPresentationRecord *> *)snapshot {
+    NSMutableArray<MKAPresentationRecord *> *records = [NSMutableArray array];
+
+    for (MKAPresentationRecord *record in self.records) {
+        if (record.hostView && record.view.superview) {
+            [records addObject:record];
+        }
+    }
+
+    [records sortUsingComparator:^NSComparisonResult(MKAPresentationRecord *record1, MKAPresentationRecord *record2) {
+        if (record1.layer != record2.layer) {
+            return record1.layer < record2.layer ? NSOrderedAscending : NSOrderedDescending;
+        }
+
+        return record1.sequence < record2.sequence ? NSOrderedAscending : NSOrderedDescending;
+    }];
+
+    return records;
+}
+
+- (NSString *)debugDescription {
+    return [NSString stringWithFormat:@"<%@: %p; snapshot = %@>", NSStringFromClass(self.class), self, self.snapshot];
+}
+
+#pragma mark - private method
+
+- (UIView *)containerForWindow:(nullable UIWindow *)window {
+    UIView *container = window ? [self.containers objectForKey:window] : nil;
+
+    if (container) {
+        return container;
+    }
+
+    container = [MKAPassThroughView new];
+    container.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+
+    for (NSInteger i = 0; i < kLayerCount; i++) {
+        UIView *layerView = [[MKAPassThroughView alloc] initWithFrame:container.bounds];
+        layerView.autoresizingMask = UIViewAutoresizingFlexibleWidth | UIViewAutoresizingFlexibleHeight;
+        [container addSubview:layerView];
+    }
+
+    if (window) {
+        [self.containers setObject:container forKey:window];
+    }
+
+    return container;
+}
+
+- (nullable MKAPresentationRecord *)recordForView:(UIView *)view {
+    return objc_getAssociatedObject(view, (__bridge const void *) self);
+}
+
+@end
@@ -0,0 +1,84 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import <UIKit/UIKit.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef NS_ENUM(NSInteger, MKAQualityLevel) {
+    /**
+     * Follows the level of the shared policy. It is used for the per-component level.
+     */
+    MKAQualityLevelAutomatic = -1,
+    /**
+     * All animations are used as they are configured.
+     */
+    MKAQualityLevelFull = 0,
+    /**
+     * Slide animations are replaced with fades, the sprite indicators run at 30 fps at most
+     * and the toasts fade in half the time.
+     */
+    MKAQualityLevelReduced,
+    /**
+     * The popups and the toasts are shown and hidden without animation,
+     * and the sprite indicators run at 15 fps at most.
+     */
+    MKAQualityLevelMinimal,
+};
+
+/**
+ * Posted on the main thread when the level of the shared policy is changed. The object is the policy.
+ */
+UIKIT_EXTERN NSNotificationName const MKAQualityPolicyLevelDidChangeNotification;
+
+/**
+ * MKAQualityPolicy decides how rich the animations of MKAPopup, MKABottomSheet, MKAToast and MKAIndicator are.
+ * The level is lowered automatically by the thermal state, Low Power Mode and Reduce Motion.
+ */
+@interface MKAQualityPolicy : NSObject
+/**
+ * The active level. It is never `MKAQualityLevelAutomatic`.
+ */
+@property (nonatomic, readonly) MKAQualityLevel level;
+/**
+ * The level used instead of the detected one. Default is `MKAQualityLevelAutomatic`.
+ */
+@property (nonatomic) MKAQualityLevel overrideLevel;
+
+/**
+ * Returns the policy shared by all components.
+ */
++ (instancetype)sharedPolicy;
+
+- (instancetype)init NS_UNAVAILABLE;
++ (instancetype)new NS_UNAVAILABLE;
+
+/**
+ * Returns given level of a component, or the active level if it is `MKAQualityLevelAutomatic`.
+ */
+- (MKAQualityLevel)levelForComponentLevel:(MKAQualityLevel)level;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,120 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#import "MKAQualityPolicy.h"
+
+NSNotificationName const MKAQualityPolicyLevelDidChangeNotification = @"jp.hituzi.MKAQualityPolicy.LevelDidChangeNotification";
+
+@interface MKAQualityPolicy ()
+
+@property (nonatomic) MKAQualityLevel level;
+
+@end
+
+@implementation MKAQualityPolicy
+
++ (instancetype)sharedPolicy {
+    static MKAQualityPolicy *policy = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        policy = [[MKAQualityPolicy alloc] initPrivately];
+    });
+
+    return policy;
+}
+
+- (instancetype)initPrivately {
+    if (self = [super init]) {
+        _overrideLevel = MKAQualityLevelAutomatic;
+        _level = [self detectLevel];
+
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        [center addObserver:self
+                   selector:@selector(systemStateDidChange:)
+                       name:NSProcessInfoThermalStateDidChangeNotification
+                     object:nil];
+        [center addObserver:self
+                   selector:@selector(systemStateDidChange:)
+                       name:NSProcessInfoPowerStateDidChangeNotification
+                     object:nil];
+        [center addObserver:self
+                   selector:@selector(systemStateDidChange:)
+                       name:UIAccessibilityReduceMotionStatusDidChangeNotification
+                     object:nil];
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (void)setOverrideLevel:(MKAQualityLevel)overrideLevel {
+    _overrideLevel = overrideLevel;
+
+    [self updateLevel];
+}
+
+#pragma mark - public method
+
+- (MKAQualityLevel)levelForComponentLevel:(MKAQualityLevel)level {
+    return level == MKAQualityLevelAutomatic ? self.level : level;
+}
+
+#pragma mark - private method
+
+- (void)systemStateDidChange:(NSNotification *)notification {
+    // The notifications of NSProcessInfo are posted on any thread.
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self updateLevel];
+    });
+}
+
+- (void)updateLevel {
+    const MKAQualityLevel level = self.overrideLevel == MKAQualityLevelAutomatic ? [self detectLevel] : self.overrideLevel;
+
+    if (level == self.level) {
+        return;
+    }
+
+    self.level = level;
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:MKAQualityPolicyLevelDidChangeNotification object:self];
+}
+
+- (MKAQualityLevel)detectLevel {
+    NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+
+    if (processInfo.thermalState >= NSProcessInfoThermalStateCritical) {
+        return MKAQualityLevelMinimal;
+    }
+    if (processInfo.thermalState >= NSProcessInfoThermalStateSerious
+        || processInfo.isLowPowerModeEnabled
+        || UIAccessibilityIsReduceMotionEnabled()) {
+        return MKAQualityLevelReduced;
+    }
+
+    return MKAQualityLevelFull;
+}
+
+@end
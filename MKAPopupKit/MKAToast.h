@@ -26,6 +26,8 @@
 
 #import <UIKit/UIKit.h>
 
+#import "MKAQualityPolicy.h"
+
 NS_ASSUME_NONNULL_BEGIN
 
 /**
@@ -75,6 +77,7 @@ UIKIT_EXTERN const CGFloat MKAToastDefaultHeight;
 @end
 
 @protocol MKAToastDelegate;
+@class MKAToastStack;
 
 /**
  * A default short display time for a toast view.
@@ -144,6 +147,19 @@ UIKIT_EXTERN const NSTimeInterval MKAToastTimeForever;
  * Sets a delay in seconds that the toast view is shown after it.
  */
 - (instancetype)withDelay:(NSTimeInterval)delay;
+/**
+ * Sets a toast stack. When the stack is set, `show` method pushes the toast view to it
+ * instead of placing the toast view at the fixed location.
+ */
+- (instancetype)withStack:(nullable MKAToastStack *)stack;
+/**
+ * Sets a scene where the toast view is shown. If it is nil, the toast view is shown in the foreground active scene.
+ */
+- (instancetype)withWindowScene:(nullable UIWindowScene *)scene;
+/**
+ * Sets a quality level of the fade animations. Default is `MKAQualityLevelAutomatic`, that follows the shared policy.
+ */
+- (instancetype)withQualityLevel:(MKAQualityLevel)level;
 /**
  * Shows the toast view with the animation in configured time. After fading out, it is separated from the parent view.
  */
@@ -153,8 +169,22 @@ UIKIT_EXTERN const NSTimeInterval MKAToastTimeForever;
  */
 - (void)showAtLocation:(CGPoint)center NS_SWIFT_NAME(show(at:));
 /**
+ * Hides the toast view with the fade out animation while it is fading in or displayed, even before the display time elapses.
  */
 - (void)hide;
+/**
+ * Removes the toast view at once at any point of its lifecycle. The timers and the animations are canceled,
+ * and the toast is also removed from the queue of its stack.
+ */
+- (void)dismiss;
+/**
+ * Dismisses all queued or displayed toasts at once.
+ */
++ (void)dismissAllToasts;
+/**
+ * Dismisses queued or displayed toasts that have given tag at once.
+ */
++ (void)dismissToastsWithTag:(NSInteger)tag;
 
 /**
  * Shows a toast view with the animation in default time. After fading out, it is separated from the parent view.
@@ -204,6 +234,53 @@ UIKIT_EXTERN const NSTimeInterval MKAToastTimeForever;
 
 @end
 
+/**
+ * A default maximum number of toast views that a toast stack displays at the same time.
+ */
+UIKIT_EXTERN const NSUInteger MKAToastStackDefaultMaximumVisibleCount;
+
+/**
+ * MKAToastStack lays out toast views vertically so that they do not overlap each other.
+ * The newest toast view is placed at the bottom and older ones are pushed up.
+ * Toast views exceeding `maximumVisibleCount` wait in the queue until a displayed toast view disappears.
+ */
+@interface MKAToastStack : NSObject
+/**
+ * The maximum number of toast views displayed at the same time. Default is `MKAToastStackDefaultMaximumVisibleCount`.
+ */
+@property (nonatomic) NSUInteger maximumVisibleCount;
+/**
+ * A vertical space between toast views.
+ */
+@property (nonatomic) CGFloat spacing;
+/**
+ * A margin between the bottom of the root view and the newest toast view.
+ */
+@property (nonatomic) CGFloat bottomMargin;
+/**
+ * A duration in seconds of the animation moving toast views when the stack changes.
+ */
+@property (nonatomic) NSTimeInterval animationDuration;
+/**
+ * Displayed toast views. The first one is the newest.
+ */
+@property (nonatomic, readonly) NSArray<MKAToast *> *visibleToasts;
+/**
+ * Toast views waiting to be displayed. The first one is displayed first.
+ */
+@property (nonatomic, readonly) NSArray<MKAToast *> *queuedToasts;
+
+/**
+ * Returns the shared toast stack.
+ */
++ (instancetype)defaultStack;
+/**
+ * Shows given toast view at the bottom of the stack. If the stack is full, the toast view is queued.
+ */
+- (void)pushToast:(MKAToast *)toast NS_SWIFT_NAME(push(_:));
+
+@end
+
 /**
  * Shows the toast view in specified time. After fading out, it is separated from the parent view.
  */
@@ -26,7 +26,13 @@
 
 #import "MKAToast.h"
 
+#import "MKAAnimationSuspender.h"
+#import "MKAFlightRecording.h"
+#import "MKALifecycle.h"
 #import "MKAPopupKitHelper.h"
+#import "MKAPresentationCoordinator.h"
+#import "MKARenderer.h"
+#import "MKAScheduler.h"
 
 const CGFloat MKAToastDefaultWidth = 300.f;
 const CGFloat MKAToastDefaultHeight = 80.f;
@@ -63,7 +69,7 @@ const NSTimeInterval MKAToastTimeShort = 3.0;
 const NSTimeInterval MKAToastTimeLong = 5.0;
 const NSTimeInterval MKAToastTimeForever = -1.0;
 
-@interface MKAToast ()
+@interface MKAToast () <MKAAnimationSuspendable>
 
 @property (nonatomic) UILabel *label;
 /**
@@ -83,15 +89,42 @@ const NSTimeInterval MKAToastTimeForever = -1.0;
  */
 @property (nonatomic) NSTimeInterval delay;
 @property (nonatomic) BOOL isTouched;
+/**
+ * A toast stack that lays out the toast view.
+ */
+@property (nonatomic, nullable) MKAToastStack *stack;
+/**
+ * A timer that hides the toast view when the display time elapses.
+ */
+@property (nonatomic) MKAClockTimer hideTimer;
+/**
+ * A timer that ends the running fade in or fade out.
+ */
+@property (nonatomic) MKAClockTimer fadeTimer;
+@property (nonatomic) MKAQualityLevel qualityLevel;
+@property (nonatomic, weak, nullable) UIWindowScene *windowScene;
 
 @end
 
-@implementation MKAToast
+@interface MKAToastStack ()
+
+- (BOOL)isQueuingToast:(MKAToast *)toast;
+- (void)removeToast:(MKAToast *)toast;
+
+@end
+
+@implementation MKAToast {
+    MKAToastLifecycle _lifecycle;
+}
 
 static const NSTimeInterval kDefaultAnimationDuration = .3;
 
 static MKAToastStyleConfiguration *_config = nil;
 static NSMutableDictionary<NSString *, MKAToastStyleConfiguration *> *_styleConfigCaches = nil;
+/**
+ * Toasts that are queued or displayed. They are dismissed in bulk without walking the view hierarchy.
+ */
+static NSHashTable<MKAToast *> *_activeToasts = nil;
 
 + (instancetype)toastWithText:(NSString *)text {
     // Sets default style configuration when it's not set yet.
@@ -115,10 +148,12 @@ static NSMutableDictionary<NSString *, MKAToastStyleConfiguration *> *_styleConf
         _animationDuration = kDefaultAnimationDuration;
         _time = MKAToastTimeShort;
         _delay = 0;
+        _qualityLevel = MKAQualityLevelAutomatic;
+        MKAToastLifecycleInit(&_lifecycle, _time);
         self.backgroundColor = styleConfig.backgroundColor;
 
         // Adds left and right margin.
-        _label = [[UILabel alloc] initWithFrame:CGRectMake(20.f, 0, frame.size.width - 40.f, 0)];
+        _label = [[UILabel alloc] initWithFrame:CGRectMake(20.f, 0, MKALayoutToastLabelWidth(frame.size.width, 20.f), 0)];
 
         _label.text = text;
         _label.textColor = styleConfig.textColor;
@@ -132,7 +167,8 @@ static NSMutableDictionary<NSString *, MKAToastStyleConfiguration *> *_styleConf
 
         [self addSubview:_label];
 
-        _label.center = CGPointMake(frame.size.width * .5f, frame.size.height * .5f);
+        MKARendererSetFrame(_label, CGRectFromMKALayoutRect(MKALayoutToastLabel(MKALayoutSizeFromCGSize(frame.size),
+                                                                                MKALayoutSizeFromCGSize(_label.bounds.size))));
 
         self.layer.cornerRadius = frame.size.height * .5f;
 
@@ -149,6 +185,12 @@ static NSMutableDictionary<NSString *, MKAToastStyleConfiguration *> *_styleConf
     self.isTouched = YES;
 }
 
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+
+    [[MKAAnimationSuspender sharedSuspender] setNeedsUpdate];
+}
+
 - (void)touchesEnded:(NSSet<UITouch *> *)touches withEvent:(UIEvent *)event {
     if (self.isTouched && [event touchesForView:self].count > 0) {
         if ([self.delegate respondsToSelector:@selector(toastClicked:)]) {
@@ -194,49 +236,154 @@ static NSMutableDictionary<NSString *, MKAToastStyleConfiguration *> *_styleConf
     return self;
 }
 
+- (instancetype)withStack:(nullable MKAToastStack *)stack {
+    self.stack = stack;
+    return self;
+}
+
+- (instancetype)withWindowScene:(nullable UIWindowScene *)scene {
+    self.windowScene = scene;
+    return self;
+}
+
+- (instancetype)withQualityLevel:(MKAQualityLevel)level {
+    self.qualityLevel = level;
+    return self;
+}
+
 - (void)show {
+    [MKAToast addActiveToast:self];
+
+    if (self.stack) {
+        [self.stack pushToast:self];
+        return;
+    }
+
     // Places horizontal center adding margin bottom.
-    UIView *view = [MKAPopupKitHelper rootView];
-    [self showAtLocation:CGPointMake(view.center.x, view.frame.size.height - 56.f - self.frame.size.height / 2.f)];
+    UIView *view = [MKAPopupKitHelper rootViewInScene:self.windowScene];
+    MKALayoutPoint center = MKALayoutToastCenter(MKALayoutSizeFromCGSize(view.bounds.size),
+                                                 MKALayoutSizeFromCGSize(self.bounds.size),
+                                                 56.f,
+                                                 MKALayoutInsetsZero);
+    [self showAtLocation:CGPointFromMKALayoutPoint(center)];
 }
 
 - (void)showAtLocation:(CGPoint)center {
+    // The display time may be changed after the toast was created.
+    _lifecycle.holdTime = self.time;
+
+    const BOOL isShown = MKAToastLifecycleShow(&_lifecycle);
+    MKAFlightRecordEvent(&(MKAFlightEvent) {
+        .object = MKAFlightObject(self),
+        .value = self.time,
+        .type = MKAFlightEventTypeToastShow,
+        .result = isShown,
+    });
+
+    if (!isShown) {
+        return;
+    }
+
+    [MKAToast addActiveToast:self];
+
     if ([self.delegate respondsToSelector:@selector(toastWillAppear:)]) {
         [self.delegate toastWillAppear:self];
     }
 
-    UIView *view = [MKAPopupKitHelper rootView];
-    [view addSubview:self];
-    self.center = center;
+    [[MKAPresentationCoordinator sharedCoordinator] presentView:self
+                                                        inLayer:MKAPresentationLayerToast
+                                                          scene:self.windowScene];
+    MKARendererSetFrame(self, (CGRect) {
+        { center.x - self.bounds.size.width / 2.0, center.y - self.bounds.size.height / 2.0 }, self.bounds.size
+    });
+
+    [[MKAAnimationSuspender sharedSuspender] addSuspendable:self];
 
     self.alpha = 0;
-    [UIView animateWithDuration:self.animationDuration
+    MKARendererBeginAnimation(self, [self fadeDuration]);
+    [UIView animateWithDuration:[self fadeDuration]
                           delay:self.delay
                         options:UIViewAnimationOptionBeginFromCurrentState | UIViewAnimationOptionAllowUserInteraction
                      animations:^{
                          self.alpha = 1.f;
                      }
-                     completion:^(BOOL b) {
-                         if (self.time != MKAToastTimeForever) {
-                             [NSTimer scheduledTimerWithTimeInterval:self.time
-                                                              target:self
-                                                            selector:@selector(hide:)
-                                                            userInfo:nil
-                                                             repeats:NO];
-                         }
+                     completion:nil];
+
+    __weak typeof(self) weakSelf = self;
+
+    // The end of the fade is scheduled on the clock instead of the animation, so the lifecycle follows a virtual time.
+    self.fadeTimer = MKASchedulerSchedule(self.delay + [self fadeDuration], ^{
+        typeof(self) strongSelf = weakSelf;
+        double delay;
+
+        if (!strongSelf) {
+            return;
+        }
+
+        const BOOL needsHideTimer = MKAToastLifecycleFadeInFinished(&strongSelf->_lifecycle, MKASchedulerNow(), &delay);
+        MKAFlightRecord(MKAFlightEventTypeToastFadeInFinished, strongSelf, needsHideTimer, 0);
 
-                         if ([self.delegate respondsToSelector:@selector(toastDidAppear:)]) {
-                             [self.delegate toastDidAppear:self];
-                         }
-                     }];
+        if (needsHideTimer) {
+            [strongSelf startHideTimerAfter:delay];
+        }
+
+        MKAFlightRecord(MKAFlightEventTypeToastDidAppear, strongSelf, 0, 0);
+
+        if ([strongSelf.delegate respondsToSelector:@selector(toastDidAppear:)]) {
+            [strongSelf.delegate toastDidAppear:strongSelf];
+        }
+    });
 }
 
 - (void)hide {
-    if (self.time == MKAToastTimeForever) {
-        [self hide:nil];
+    [self hideManually:YES];
+}
+
+- (void)dismiss {
+    [_activeToasts removeObject:self];
+
+    const MKAToastState state = MKAToastLifecycleCancel(&_lifecycle);
+    MKAFlightRecord(MKAFlightEventTypeToastCancel, self, (uint8_t) state, 0);
+
+    MKASchedulerCancel(self.hideTimer);
+    MKASchedulerCancel(self.fadeTimer);
+    self.hideTimer = 0;
+    self.fadeTimer = 0;
+    [[MKAAnimationSuspender sharedSuspender] removeSuspendable:self];
+    [self.layer removeAllAnimations];
+
+    // Removes it from the queue of the stack too.
+    [self.stack removeToast:self];
+
+    if (state == MKAToastStateIdle || state == MKAToastStateFinished) {
+        return;
+    }
+
+    if (state != MKAToastStateFadingOut && [self.delegate respondsToSelector:@selector(toastWillDisappear:)]) {
+        [self.delegate toastWillDisappear:self];
+    }
+
+    self.alpha = 0;
+    [[MKAPresentationCoordinator sharedCoordinator] dismissView:self];
+    MKAFlightRecord(MKAFlightEventTypeToastDidDisappear, self, 0, 0);
+
+    if ([self.delegate respondsToSelector:@selector(toastDidDisappear:)]) {
+        [self.delegate toastDidDisappear:self];
     }
 }
 
++ (void)dismissAllToasts {
+    [self dismissToastsPassingTest:^BOOL(MKAToast *toast) {
+        return YES;
+    }];
+}
+
++ (void)dismissToastsWithTag:(NSInteger)tag {
+    [self dismissToastsPassingTest:^BOOL(MKAToast *toast) {
+        return toast.tag == tag;
+    }];
+}
+
 + (void)showText:(NSString *)text {
     [[MKAToast toastWithText:text] show];
 }
@@ -277,24 +424,288 @@ static NSMutableDictionary<NSString *, MKAToastStyleConfiguration *> *_styleConf
 
 #pragma mark - private method
 
-- (void)hide:(NSTimer *)timer {
++ (void)addActiveToast:(MKAToast *)toast {
+    if (!_activeToasts) {
+        _activeToasts = [NSHashTable weakObjectsHashTable];
+    }
+
+    [_activeToasts addObject:toast];
+}
+
+/**
+ * Dismisses the queued toasts before the displayed ones, so a displayed toast leaving its stack does not present
+ * a queued toast that is dismissed right after.
+ */
++ (void)dismissToastsPassingTest:(BOOL (^)(MKAToast *toast))predicate {
+    NSMutableArray<MKAToast *> *displayedToasts = [NSMutableArray array];
+
+    for (MKAToast *toast in _activeToasts.allObjects) {
+        if (!predicate(toast)) {
+            continue;
+        }
+
+        if ([toast.stack isQueuingToast:toast]) {
+            [toast dismiss];
+        } else {
+            [displayedToasts addObject:toast];
+        }
+    }
+
+    for (MKAToast *toast in displayedToasts) {
+        [toast dismiss];
+    }
+}
+
+/**
+ * Returns the duration of the fade animations shortened by the quality level.
+ */
+- (NSTimeInterval)fadeDuration {
+    switch ([[MKAQualityPolicy sharedPolicy] levelForComponentLevel:self.qualityLevel]) {
+        case MKAQualityLevelReduced:
+            return self.animationDuration * .5;
+        case MKAQualityLevelMinimal:
+            return 0;
+        default:
+            return self.animationDuration;
+    }
+}
+
+- (void)startHideTimerAfter:(NSTimeInterval)delay {
+    __weak typeof(self) weakSelf = self;
+
+    self.hideTimer = MKASchedulerSchedule(delay, ^{
+        [weakSelf hideManually:NO];
+    });
+}
+
+- (void)hideManually:(BOOL)isManual {
+    const BOOL isHidden = MKAToastLifecycleHide(&_lifecycle, isManual);
+    MKAFlightRecordEvent(&(MKAFlightEvent) {
+        .object = MKAFlightObject(self),
+        .type = MKAFlightEventTypeToastHide,
+        .result = isHidden,
+        .flags = isManual,
+    });
+
+    if (!isHidden) {
+        return;
+    }
+
+    MKASchedulerCancel(self.hideTimer);
+    MKASchedulerCancel(self.fadeTimer);
+    self.hideTimer = 0;
+    [[MKAAnimationSuspender sharedSuspender] removeSuspendable:self];
+
     if ([self.delegate respondsToSelector:@selector(toastWillDisappear:)]) {
         [self.delegate toastWillDisappear:self];
     }
 
-    [UIView animateWithDuration:self.animationDuration
+    MKARendererBeginAnimation(self, [self fadeDuration]);
+    [UIView animateWithDuration:[self fadeDuration]
                           delay:0
                         options:UIViewAnimationOptionBeginFromCurrentState | UIViewAnimationOptionAllowUserInteraction
                      animations:^{
                          self.alpha = 0;
                      }
-                     completion:^(BOOL b) {
-                         [self removeFromSuperview];
+                     completion:nil];
+
+    __weak typeof(self) weakSelf = self;
+
+    self.fadeTimer = MKASchedulerSchedule([self fadeDuration], ^{
+        typeof(self) strongSelf = weakSelf;
+
+        if (!strongSelf) {
+            return;
+        }
+
+        [_activeToasts removeObject:strongSelf];
+        const BOOL isFinished = MKAToastLifecycleFadeOutFinished(&strongSelf->_lifecycle);
+        MKAFlightRecord(MKAFlightEventTypeToastFadeOutFinished, strongSelf, isFinished, 0);
+        [[MKAPresentationCoordinator sharedCoordinator] dismissView:strongSelf];
+        [strongSelf.stack removeToast:strongSelf];
+        MKAFlightRecord(MKAFlightEventTypeToastDidDisappear, strongSelf, 0, 0);
+
+        if ([strongSelf.delegate respondsToSelector:@selector(toastDidDisappear:)]) {
+            [strongSelf.delegate toastDidDisappear:strongSelf];
+        }
+    });
+}
+
+#pragma mark - MKAAnimationSuspendable
+
+- (nullable UIView *)suspendableView {
+    return self.superview ? self : nil;
+}
+
+- (void)setAnimationSuspended:(BOOL)suspended {
+    if (suspended) {
+        // Keeps the rest of the display time while the toast view can not be seen.
+        const BOOL needsStopHideTimer = MKAToastLifecycleSuspend(&_lifecycle, MKASchedulerNow());
+        MKAFlightRecord(MKAFlightEventTypeToastSuspend, self, needsStopHideTimer, 0);
+
+        if (needsStopHideTimer) {
+            MKASchedulerCancel(self.hideTimer);
+            self.hideTimer = 0;
+        }
+    }
+    else {
+        double delay;
+
+        const BOOL needsHideTimer = MKAToastLifecycleResume(&_lifecycle, MKASchedulerNow(), &delay);
+        MKAFlightRecord(MKAFlightEventTypeToastResume, self, needsHideTimer, 0);
+
+        if (needsHideTimer) {
+            [self startHideTimerAfter:delay];
+        }
+    }
+}
+
+@end
+
+const NSUInteger MKAToastStackDefaultMaximumVisibleCount = 3;
+
+@interface MKAToastStack ()
+
+@property (nonatomic) NSMutableArray<MKAToast *> *toasts;
+@property (nonatomic) NSMutableArray<MKAToast *> *queue;
+
+@end
+
+@implementation MKAToastStack
+
++ (instancetype)defaultStack {
+    static MKAToastStack *stack = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        stack = [MKAToastStack new];
+    });
+
+    return stack;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _maximumVisibleCount = MKAToastStackDefaultMaximumVisibleCount;
+        _spacing = 8.f;
+        _bottomMargin = 56.f;
+        _animationDuration = kDefaultAnimationDuration;
+        _toasts = [NSMutableArray array];
+        _queue = [NSMutableArray array];
+    }
+
+    return self;
+}
+
+#pragma mark - property
+
+- (NSArray<MKAToast *> *)visibleToasts {
+    return [self.toasts copy];
+}
 
-                         if ([self.delegate respondsToSelector:@selector(toastDidDisappear:)]) {
-                             [self.delegate toastDidDisappear:self];
-                         }
-                     }];
+- (NSArray<MKAToast *> *)queuedToasts {
+    return [self.queue copy];
+}
+
+#pragma mark - public method
+
+- (void)pushToast:(MKAToast *)toast {
+    if ([self.toasts containsObject:toast] || [self.queue containsObject:toast]) {
+        return;
+    }
+
+    toast.stack = self;
+
+    if (self.toasts.count >= self.maximumVisibleCount) {
+        [self.queue addObject:toast];
+        MKAFlightRecord(MKAFlightEventTypeToastEnqueue, toast, 0, (uint32_t) self.queue.count);
+        return;
+    }
+
+    [self showToasts:@[toast]];
+}
+
+#pragma mark - private method
+
+- (BOOL)isQueuingToast:(MKAToast *)toast {
+    return [self.queue containsObject:toast];
+}
+
+/**
+ * Shows given toasts in order, with one reflow for all of them.
+ */
+- (void)showToasts:(NSArray<MKAToast *> *)toasts {
+    for (MKAToast *toast in toasts) {
+        [self.toasts insertObject:toast atIndex:0];
+        toast.transform = CGAffineTransformIdentity;
+    }
+
+    [self reflow];
+
+    for (MKAToast *toast in toasts) {
+        // Places the newest toast view at the bottom. Older ones are moved by their transforms.
+        UIView *view = [MKAPopupKitHelper rootViewInScene:toast.windowScene];
+        MKALayoutPoint center = MKALayoutToastCenter(MKALayoutSizeFromCGSize(view.bounds.size),
+                                                     MKALayoutSizeFromCGSize(toast.bounds.size),
+                                                     self.bottomMargin,
+                                                     MKALayoutInsetsZero);
+        [toast showAtLocation:CGPointFromMKALayoutPoint(center)];
+    }
+}
+
+- (void)removeToast:(MKAToast *)toast {
+    if ([self.queue containsObject:toast]) {
+        [self.queue removeObject:toast];
+        return;
+    }
+
+    if (![self.toasts containsObject:toast]) {
+        return;
+    }
+
+    [self.toasts removeObject:toast];
+    toast.transform = CGAffineTransformIdentity;
+
+    // Dequeues first, so the removed slot and the dequeued toasts are laid out in one reflow.
+    NSMutableArray<MKAToast *> *dequeuedToasts = [NSMutableArray array];
+
+    while (self.queue.count > 0 && self.toasts.count + dequeuedToasts.count < self.maximumVisibleCount) {
+        MKAToast *next = self.queue.firstObject;
+        [self.queue removeObjectAtIndex:0];
+        MKAFlightRecord(MKAFlightEventTypeToastDequeue, next, 0, (uint32_t) self.queue.count);
+        [dequeuedToasts addObject:next];
+    }
+
+    [self showToasts:dequeuedToasts];
+}
+
+/**
+ * Moves displayed toast views to their slots in one animation.
+ * Each offset is calculated from the current heights, so the texts are not measured again.
+ */
+- (void)reflow {
+    NSArray<MKAToast *> *toasts = [self.toasts copy];
+    NSMutableData *heights = [NSMutableData dataWithLength:toasts.count * sizeof(double)];
+    NSMutableData *offsets = [NSMutableData dataWithLength:toasts.count * sizeof(double)];
+
+    [toasts enumerateObjectsUsingBlock:^(MKAToast *toast, NSUInteger idx, BOOL *stop) {
+        ((double *) heights.mutableBytes)[idx] = toast.bounds.size.height;
+    }];
+    MKALayoutToastStack(heights.bytes, toasts.count, self.spacing, offsets.mutableBytes);
+
+    const BOOL isAnimated = [MKAQualityPolicy sharedPolicy].level != MKAQualityLevelMinimal;
+
+    MKARendererBeginAnimation(nil, isAnimated ? self.animationDuration : 0);
+    [UIView animateWithDuration:isAnimated ? self.animationDuration : 0
+                          delay:0
+                        options:UIViewAnimationOptionBeginFromCurrentState | UIViewAnimationOptionAllowUserInteraction
+                     animations:^{
+                         const double *values = offsets.bytes;
+
+                         [toasts enumerateObjectsUsingBlock:^(MKAToast *toast, NSUInteger idx, BOOL *stop) {
+                             toast.transform = CGAffineTransformMakeTranslation(0, -values[idx]);
+                         }];
+                     }
+                     completion:nil];
 }
 
 @end
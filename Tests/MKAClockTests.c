@@ -0,0 +1,350 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKAClock.h"
+#include "MKALifecycle.h"
+#include "MKATest.h"
+
+static MKAVirtualTimer _timers[16];
+static MKAVirtualClock _virtualClock;
+static MKAClock _clock;
+
+static void MKAClockTestSetUp(void) {
+    MKAVirtualClockInit(&_virtualClock, _timers, sizeof(_timers) / sizeof(_timers[0]), 100);
+    _clock = MKAVirtualClockMakeClock(&_virtualClock);
+}
+
+/**
+ * Records the order and the time of the fired timers.
+ */
+typedef struct MKAFiring {
+    int ids[16];
+    double times[16];
+    int count;
+} MKAFiring;
+
+static MKAFiring _firing;
+
+typedef struct MKATimerInfo {
+    int identifier;
+    /**
+     * A delay of a timer scheduled by the callback. Negative not to schedule.
+     */
+    double nextDelay;
+} MKATimerInfo;
+
+static void MKARecordFiring(void *info) {
+    const MKATimerInfo *timerInfo = info;
+
+    _firing.ids[_firing.count] = timerInfo->identifier;
+    _firing.times[_firing.count] = MKAClockNow(&_clock);
+    _firing.count++;
+
+    if (timerInfo->nextDelay >= 0) {
+        static MKATimerInfo next = { 99, -1 };
+        MKAClockSchedule(&_clock, timerInfo->nextDelay, MKARecordFiring, &next);
+    }
+}
+
+// MARK: - virtual clock
+
+static void testFiresInOrderOfFireTimes(void) {
+    MKAClockTestSetUp();
+    _firing.count = 0;
+
+    MKATimerInfo first = { 1, -1 }, second = { 2, -1 }, third = { 3, -1 }, sameTime = { 4, -1 };
+
+    MKAClockSchedule(&_clock, 3, MKARecordFiring, &third);
+    MKAClockSchedule(&_clock, 1, MKARecordFiring, &first);
+    MKAClockSchedule(&_clock, 2, MKARecordFiring, &second);
+    MKAClockSchedule(&_clock, 2, MKARecordFiring, &sameTime);
+
+    MKAAssertEqualDouble(MKAClockNow(&_clock), 100);
+    MKAAssertEqual(MKAVirtualClockAdvance(&_virtualClock, 2.5), 3UL);
+
+    // The timers due at the same time fire in the scheduled order, at their own fire times.
+    MKAAssertEqual(_firing.count, 3);
+    MKAAssertEqual(_firing.ids[0], 1);
+    MKAAssertEqual(_firing.ids[1], 2);
+    MKAAssertEqual(_firing.ids[2], 4);
+    MKAAssertEqualDouble(_firing.times[0], 101);
+    MKAAssertEqualDouble(_firing.times[2], 102);
+    MKAAssertEqualDouble(MKAClockNow(&_clock), 102.5);
+
+    MKAAssertEqual(MKAVirtualClockAdvance(&_virtualClock, 0.5), 1UL);
+    MKAAssertEqual(_firing.ids[3], 3);
+    MKAAssertEqual(_virtualClock.count, 0UL);
+}
+
+static void testCancel(void) {
+    MKAClockTestSetUp();
+    _firing.count = 0;
+
+    MKATimerInfo first = { 1, -1 }, second = { 2, -1 };
+    const MKAClockTimer timer = MKAClockSchedule(&_clock, 1, MKARecordFiring, &first);
+    MKAClockSchedule(&_clock, 1, MKARecordFiring, &second);
+
+    MKAAssert(timer != 0);
+    MKAClockCancel(&_clock, timer);
+    // Canceling twice or canceling zero does nothing.
+    MKAClockCancel(&_clock, timer);
+    MKAClockCancel(&_clock, 0);
+
+    MKAAssertEqual(MKAVirtualClockAdvance(&_virtualClock, 1), 1UL);
+    MKAAssertEqual(_firing.ids[0], 2);
+}
+
+static void testTimersScheduledByCallbacks(void) {
+    MKAClockTestSetUp();
+    _firing.count = 0;
+
+    MKATimerInfo chained = { 1, 0.5 };
+    MKAClockSchedule(&_clock, 1, MKARecordFiring, &chained);
+
+    // The chained timer is due within the interval, so it fires in the same advance.
+    MKAAssertEqual(MKAVirtualClockAdvance(&_virtualClock, 2), 2UL);
+    MKAAssertEqual(_firing.ids[1], 99);
+    MKAAssertEqualDouble(_firing.times[1], 101.5);
+}
+
+static void testZeroAndNegativeDelays(void) {
+    MKAClockTestSetUp();
+    _firing.count = 0;
+
+    MKATimerInfo info = { 1, -1 };
+    MKAClockSchedule(&_clock, 0, MKARecordFiring, &info);
+    MKAClockSchedule(&_clock, -5, MKARecordFiring, &info);
+
+    MKAAssertEqual(MKAVirtualClockAdvance(&_virtualClock, 0), 2UL);
+    MKAAssertEqualDouble(_firing.times[1], 100);
+}
+
+static void testCapacity(void) {
+    MKAVirtualTimer timers[2];
+    MKAVirtualClock virtualClock;
+    MKATimerInfo info = { 1, -1 };
+
+    MKAVirtualClockInit(&virtualClock, timers, 2, 0);
+    MKAClock clock = MKAVirtualClockMakeClock(&virtualClock);
+
+    MKAAssert(MKAClockSchedule(&clock, 1, MKARecordFiring, &info) != 0);
+    MKAAssert(MKAClockSchedule(&clock, 1, MKARecordFiring, &info) != 0);
+    MKAAssertEqual(MKAClockSchedule(&clock, 1, MKARecordFiring, &info), 0UL);
+    MKAAssertEqual(MKAClockSchedule(&clock, 1, NULL, &info), 0UL);
+}
+
+static void testRunUntilIdle(void) {
+    MKAClockTestSetUp();
+    _firing.count = 0;
+
+    MKATimerInfo first = { 1, -1 }, late = { 2, -1 };
+    MKAClockSchedule(&_clock, 5, MKARecordFiring, &first);
+    MKAClockSchedule(&_clock, 50, MKARecordFiring, &late);
+
+    // Stops before the timer beyond the limit and leaves the time at the last fired timer.
+    MKAAssertEqual(MKAVirtualClockRunUntilIdle(&_virtualClock, 10), 1UL);
+    MKAAssertEqualDouble(MKAClockNow(&_clock), 105);
+    MKAAssertEqual(_virtualClock.count, 1UL);
+
+    MKAAssertEqual(MKAVirtualClockRunUntilIdle(&_virtualClock, 100), 1UL);
+    MKAAssertEqualDouble(MKAClockNow(&_clock), 150);
+}
+
+static void testNullClock(void) {
+    MKATimerInfo info = { 1, -1 };
+
+    MKAAssertEqualDouble(MKAClockNow(NULL), 0);
+    MKAAssertEqual(MKAClockSchedule(NULL, 1, MKARecordFiring, &info), 0UL);
+    MKAClockCancel(NULL, 1);
+}
+
+// MARK: - fast-forwarding lifecycles
+
+/**
+ * A toast driven by the virtual clock the same way as MKAToast drives it: 0.3 seconds fades around the hold time.
+ */
+typedef struct MKAToastDriver {
+    MKAToastLifecycle lifecycle;
+    MKAClockTimer hideTimer;
+    double finishedTime;
+} MKAToastDriver;
+
+static void MKAToastDriverFadeOutFinished(void *info) {
+    MKAToastDriver *driver = info;
+
+    if (MKAToastLifecycleFadeOutFinished(&driver->lifecycle)) {
+        driver->finishedTime = MKAClockNow(&_clock);
+    }
+}
+
+static void MKAToastDriverHide(void *info) {
+    MKAToastDriver *driver = info;
+    driver->hideTimer = 0;
+
+    if (MKAToastLifecycleHide(&driver->lifecycle, false)) {
+        MKAClockSchedule(&_clock, 0.3, MKAToastDriverFadeOutFinished, driver);
+    }
+}
+
+static void MKAToastDriverFadeInFinished(void *info) {
+    MKAToastDriver *driver = info;
+    double delay;
+
+    if (MKAToastLifecycleFadeInFinished(&driver->lifecycle, MKAClockNow(&_clock), &delay)) {
+        driver->hideTimer = MKAClockSchedule(&_clock, delay, MKAToastDriverHide, driver);
+    }
+}
+
+static void MKAToastDriverShow(MKAToastDriver *driver, double holdTime) {
+    MKAToastLifecycleInit(&driver->lifecycle, holdTime);
+    driver->hideTimer = 0;
+    driver->finishedTime = -1;
+
+    MKAToastLifecycleShow(&driver->lifecycle);
+    MKAClockSchedule(&_clock, 0.3, MKAToastDriverFadeInFinished, driver);
+}
+
+static void MKAToastDriverSuspend(MKAToastDriver *driver, bool isSuspended) {
+    double delay;
+
+    if (isSuspended) {
+        if (MKAToastLifecycleSuspend(&driver->lifecycle, MKAClockNow(&_clock))) {
+            MKAClockCancel(&_clock, driver->hideTimer);
+            driver->hideTimer = 0;
+        }
+    }
+    else if (MKAToastLifecycleResume(&driver->lifecycle, MKAClockNow(&_clock), &delay)) {
+        driver->hideTimer = MKAClockSchedule(&_clock, delay, MKAToastDriverHide, driver);
+    }
+}
+
+static void testFastForwardToast(void) {
+    MKAClockTestSetUp();
+    MKAToastDriver driver;
+
+    MKAToastDriverShow(&driver, 2);
+
+    MKAVirtualClockAdvance(&_virtualClock, 1);
+    MKAAssertEqual(driver.lifecycle.state, MKAToastStateHolding);
+
+    // The rest of the 3 fired timers run without waiting.
+    MKAAssertEqual(MKAVirtualClockRunUntilIdle(&_virtualClock, 60), 2UL);
+    MKAAssertEqual(driver.lifecycle.state, MKAToastStateFinished);
+    MKAAssertEqualDouble(driver.finishedTime, 100 + 0.3 + 2 + 0.3);
+}
+
+static void testFastForwardSuspendedToast(void) {
+    MKAClockTestSetUp();
+    MKAToastDriver driver;
+
+    MKAToastDriverShow(&driver, 2);
+
+    // Hidden from 1.3 seconds for 10 seconds: 1 second of the hold time is left.
+    MKAVirtualClockAdvance(&_virtualClock, 1.3);
+    MKAToastDriverSuspend(&driver, true);
+    MKAVirtualClockAdvance(&_virtualClock, 10);
+    MKAAssertEqual(driver.lifecycle.state, MKAToastStateHolding);
+    MKAAssertEqual(_virtualClock.count, 0UL);
+
+    MKAToastDriverSuspend(&driver, false);
+    MKAVirtualClockRunUntilIdle(&_virtualClock, 60);
+
+    MKAAssertEqualDouble(driver.finishedTime, 100 + 1.3 + 10 + 1 + 0.3);
+}
+
+static void testFastForwardManyToasts(void) {
+    MKAVirtualTimer timers[1024];
+    MKAVirtualClock virtualClock;
+    static MKAToastDriver drivers[256];
+
+    MKAVirtualClockInit(&virtualClock, timers, 1024, 0);
+    _clock = MKAVirtualClockMakeClock(&virtualClock);
+
+    for (int i = 0; i < 256; i++) {
+        MKAToastDriverShow(&drivers[i], 1 + i % 4);
+    }
+
+    // An hour of virtual time with 256 toasts runs at once.
+    MKAVirtualClockRunUntilIdle(&virtualClock, 3600);
+
+    for (int i = 0; i < 256; i++) {
+        MKAAssertEqual(drivers[i].lifecycle.state, MKAToastStateFinished);
+        MKAAssertEqualDouble(drivers[i].finishedTime, 0.6 + 1 + i % 4);
+    }
+}
+
+static MKAIndicatorLifecycle _indicator;
+
+static void MKAIndicatorGracePeriodElapsedCallback(void *info) {
+    (void) info;
+    MKAIndicatorLifecycleGracePeriodElapsed(&_indicator, MKAClockNow(&_clock));
+}
+
+static void MKAIndicatorMinimumDisplayTimeElapsedCallback(void *info) {
+    (void) info;
+    MKAIndicatorLifecycleMinimumDisplayTimeElapsed(&_indicator);
+}
+
+static void testFastForwardIndicator(void) {
+    MKAClockTestSetUp();
+    double delay;
+
+    MKAIndicatorLifecycleInit(&_indicator);
+    _indicator.gracePeriod = 0.5;
+    _indicator.minimumDisplayTime = 1;
+
+    MKAAssertEqual(MKAIndicatorLifecycleShow(&_indicator, MKAClockNow(&_clock), true, &delay), MKAIndicatorActionSchedulePresent);
+    MKAClockSchedule(&_clock, delay, MKAIndicatorGracePeriodElapsedCallback, NULL);
+
+    MKAVirtualClockAdvance(&_virtualClock, 0.7);
+    MKAAssertEqual(_indicator.state, MKAIndicatorStatePresented);
+    MKAAssertEqualDouble(_indicator.presentedTime, 100.5);
+
+    // Hidden 0.2 seconds after presented, so it lingers for 0.8 seconds.
+    MKAAssertEqual(MKAIndicatorLifecycleHide(&_indicator, MKAClockNow(&_clock), &delay), MKAIndicatorActionScheduleDismiss);
+    MKAAssertEqualDouble(delay, 0.8);
+    MKAClockSchedule(&_clock, delay, MKAIndicatorMinimumDisplayTimeElapsedCallback, NULL);
+
+    MKAVirtualClockAdvance(&_virtualClock, 0.79);
+    MKAAssertEqual(_indicator.state, MKAIndicatorStateLingering);
+    MKAVirtualClockAdvance(&_virtualClock, 0.01);
+    MKAAssertEqual(_indicator.state, MKAIndicatorStateHidden);
+}
+
+int main(void) {
+    MKARunTest(testFiresInOrderOfFireTimes);
+    MKARunTest(testCancel);
+    MKARunTest(testTimersScheduledByCallbacks);
+    MKARunTest(testZeroAndNegativeDelays);
+    MKARunTest(testCapacity);
+    MKARunTest(testRunUntilIdle);
+    MKARunTest(testNullClock);
+
+    MKARunTest(testFastForwardToast);
+    MKARunTest(testFastForwardSuspendedToast);
+    MKARunTest(testFastForwardManyToasts);
+    MKARunTest(testFastForwardIndicator);
+
+    return MKATestExitStatus();
+}
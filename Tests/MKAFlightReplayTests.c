@@ -0,0 +1,515 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include <string.h>
+
+#include "MKAClock.h"
+#include "MKAFlightReplay.h"
+#include "MKAFlightRing.h"
+#include "MKALifecycle.h"
+#include "MKATest.h"
+
+/*
+ * Records the sequences the way the UIKit adapters record them, with the timers on a virtual clock,
+ * and replays the recorded events through MKAFlightReplay.
+ * Given paths, it also writes a dump and a tampered dump for the command line tool.
+ */
+
+static MKAFlightSlot _slots[256];
+static MKAFlightRing _ring;
+static MKAVirtualTimer _timers[64];
+static MKAVirtualClock _virtualClock;
+static MKAClock _clock;
+
+static MKAFlightEvent _events[256];
+static MKAFlightReplayComponent _components[64];
+static MKAFlightReplay _replay;
+
+static void MKAFlightTestSetUp(void) {
+    MKAFlightRingInit(&_ring, _slots, sizeof(_slots) / sizeof(_slots[0]));
+    MKAFlightRingSetEnabled(&_ring, true);
+    MKAVirtualClockInit(&_virtualClock, _timers, sizeof(_timers) / sizeof(_timers[0]), 0);
+    _clock = MKAVirtualClockMakeClock(&_virtualClock);
+    MKAFlightReplayInit(&_replay, _components, sizeof(_components) / sizeof(_components[0]));
+}
+
+static void MKAFlightTestRecord(const void *object,
+                                MKAFlightEventType type,
+                                uint8_t result,
+                                uint32_t count,
+                                double value,
+                                double secondValue,
+                                uint8_t flags) {
+    MKAFlightEvent event;
+    memset(&event, 0, sizeof(event));
+
+    event.time = MKAClockNow(&_clock);
+    event.object = (uint64_t) (uintptr_t) object;
+    event.type = (uint16_t) type;
+    event.result = result;
+    event.count = count;
+    event.value = value;
+    event.secondValue = secondValue;
+    event.flags = flags;
+    MKAFlightRingRecord(&_ring, &event);
+}
+
+/**
+ * Counts the results of the replay of the recorded events.
+ */
+typedef struct MKAReplayCounts {
+    size_t eventCount;
+    size_t counts[MKAFlightReplayResultUnknown + 1];
+} MKAReplayCounts;
+
+static MKAReplayCounts MKAFlightTestReplay(const MKAFlightEvent *events, size_t eventCount) {
+    MKAReplayCounts counts;
+    memset(&counts, 0, sizeof(counts));
+
+    MKAFlightReplayReset(&_replay);
+    counts.eventCount = eventCount;
+
+    for (size_t i = 0; i < eventCount; i++) {
+        counts.counts[MKAFlightReplayEvent(&_replay, &events[i])]++;
+    }
+
+    return counts;
+}
+
+static MKAReplayCounts MKAFlightTestReplayRing(void) {
+    const size_t eventCount = MKAFlightRingCopyEvents(&_ring, _events, sizeof(_events) / sizeof(_events[0]));
+    return MKAFlightTestReplay(_events, eventCount);
+}
+
+// MARK: - toast
+
+/**
+ * A toast driven as MKAToast drives it: 0.3 seconds fades around the hold time.
+ */
+typedef struct MKAToastDriver {
+    MKAToastLifecycle lifecycle;
+    MKAClockTimer hideTimer;
+} MKAToastDriver;
+
+static void MKAToastDriverFadeOutFinished(void *info) {
+    MKAToastDriver *driver = info;
+    const bool isFinished = MKAToastLifecycleFadeOutFinished(&driver->lifecycle);
+
+    MKAFlightTestRecord(driver, MKAFlightEventTypeToastFadeOutFinished, isFinished, 0, 0, 0, 0);
+
+    if (isFinished) {
+        MKAFlightTestRecord(driver, MKAFlightEventTypeToastDidDisappear, 0, 0, 0, 0, 0);
+    }
+}
+
+static void MKAToastDriverHide(MKAToastDriver *driver, bool isManual) {
+    const bool isAccepted = MKAToastLifecycleHide(&driver->lifecycle, isManual);
+
+    MKAFlightTestRecord(driver, MKAFlightEventTypeToastHide, isAccepted, 0, 0, 0, isManual);
+
+    if (isAccepted) {
+        MKAClockCancel(&_clock, driver->hideTimer);
+        driver->hideTimer = 0;
+        MKAClockSchedule(&_clock, 0.3, MKAToastDriverFadeOutFinished, driver);
+    }
+}
+
+static void MKAToastDriverHideTimerFired(void *info) {
+    MKAToastDriver *driver = info;
+    driver->hideTimer = 0;
+    MKAToastDriverHide(driver, false);
+}
+
+static void MKAToastDriverFadeInFinished(void *info) {
+    MKAToastDriver *driver = info;
+    double delay;
+    const bool needsHideTimer = MKAToastLifecycleFadeInFinished(&driver->lifecycle, MKAClockNow(&_clock), &delay);
+
+    MKAFlightTestRecord(driver, MKAFlightEventTypeToastFadeInFinished, needsHideTimer, 0, 0, 0, 0);
+
+    if (needsHideTimer) {
+        driver->hideTimer = MKAClockSchedule(&_clock, delay, MKAToastDriverHideTimerFired, driver);
+        MKAFlightTestRecord(driver, MKAFlightEventTypeToastDidAppear, 0, 0, 0, 0, 0);
+    }
+}
+
+static void MKAToastDriverShow(MKAToastDriver *driver, double holdTime) {
+    MKAToastLifecycleInit(&driver->lifecycle, holdTime);
+    driver->hideTimer = 0;
+
+    const bool isAccepted = MKAToastLifecycleShow(&driver->lifecycle);
+    MKAFlightTestRecord(driver, MKAFlightEventTypeToastShow, isAccepted, 0, holdTime, 0, 0);
+
+    if (isAccepted) {
+        MKAClockSchedule(&_clock, 0.3, MKAToastDriverFadeInFinished, driver);
+    }
+}
+
+static void MKAToastDriverSuspend(MKAToastDriver *driver, bool isSuspended) {
+    double delay;
+
+    if (isSuspended) {
+        const bool needsStopHideTimer = MKAToastLifecycleSuspend(&driver->lifecycle, MKAClockNow(&_clock));
+        MKAFlightTestRecord(driver, MKAFlightEventTypeToastSuspend, needsStopHideTimer, 0, 0, 0, 0);
+
+        if (needsStopHideTimer) {
+            MKAClockCancel(&_clock, driver->hideTimer);
+            driver->hideTimer = 0;
+        }
+    }
+    else {
+        const bool needsHideTimer = MKAToastLifecycleResume(&driver->lifecycle, MKAClockNow(&_clock), &delay);
+        MKAFlightTestRecord(driver, MKAFlightEventTypeToastResume, needsHideTimer, 0, 0, 0, 0);
+
+        if (needsHideTimer) {
+            driver->hideTimer = MKAClockSchedule(&_clock, delay, MKAToastDriverHideTimerFired, driver);
+        }
+    }
+}
+
+static void MKAToastDriverCancel(MKAToastDriver *driver) {
+    MKAClockCancel(&_clock, driver->hideTimer);
+    driver->hideTimer = 0;
+    MKAFlightTestRecord(driver, MKAFlightEventTypeToastCancel, (uint8_t) MKAToastLifecycleCancel(&driver->lifecycle), 0, 0, 0, 0);
+}
+
+/**
+ * Records a stack of three toasts: one hides itself after a suspension, one is hidden by hand twice and one is canceled.
+ */
+static void MKARecordToastSequence(MKAToastDriver drivers[3]) {
+    MKAFlightTestRecord(&drivers[1], MKAFlightEventTypeToastEnqueue, 0, 1, 0, 0, 0);
+    MKAFlightTestRecord(&drivers[2], MKAFlightEventTypeToastEnqueue, 0, 2, 0, 0, 0);
+
+    MKAToastDriverShow(&drivers[0], 2);
+    MKAVirtualClockAdvance(&_virtualClock, 1);
+    MKAToastDriverSuspend(&drivers[0], true);
+    MKAVirtualClockAdvance(&_virtualClock, 5);
+    MKAToastDriverSuspend(&drivers[0], false);
+    MKAVirtualClockRunUntilIdle(&_virtualClock, 60);
+
+    MKAFlightTestRecord(&drivers[1], MKAFlightEventTypeToastDequeue, 0, 1, 0, 0, 0);
+    MKAToastDriverShow(&drivers[1], 3);
+    MKAVirtualClockAdvance(&_virtualClock, 0.5);
+    MKAToastDriverHide(&drivers[1], true);
+    MKAToastDriverHide(&drivers[1], true);
+    MKAVirtualClockRunUntilIdle(&_virtualClock, 60);
+
+    MKAFlightTestRecord(&drivers[2], MKAFlightEventTypeToastDequeue, 0, 0, 0, 0, 0);
+    MKAToastDriverShow(&drivers[2], 3);
+    MKAVirtualClockAdvance(&_virtualClock, 0.1);
+    MKAToastDriverCancel(&drivers[2]);
+    MKAVirtualClockRunUntilIdle(&_virtualClock, 60);
+}
+
+static void testToastRoundTrip(void) {
+    MKAFlightTestSetUp();
+    MKAToastDriver drivers[3];
+
+    MKARecordToastSequence(drivers);
+
+    MKAAssertEqual(drivers[0].lifecycle.state, MKAToastStateFinished);
+    MKAAssertEqual(drivers[1].lifecycle.state, MKAToastStateFinished);
+
+    const MKAReplayCounts counts = MKAFlightTestReplayRing();
+
+    // The enqueues and the dequeues before the shows are the only skipped events.
+    MKAAssert(counts.eventCount > 20);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultReproduced], counts.eventCount - 4);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultSkipped], 4UL);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultMismatched], 0UL);
+}
+
+static void testToastMismatch(void) {
+    MKAFlightTestSetUp();
+    MKAToastDriver drivers[3];
+
+    MKARecordToastSequence(drivers);
+
+    const size_t eventCount = MKAFlightRingCopyEvents(&_ring, _events, sizeof(_events) / sizeof(_events[0]));
+    size_t tamperedCount = 0;
+
+    // The second manual hide was rejected. A recording that accepted it is not reproduced.
+    for (size_t i = 1; i < eventCount; i++) {
+        if (_events[i].type == MKAFlightEventTypeToastHide && _events[i - 1].type == MKAFlightEventTypeToastHide) {
+            MKAAssertEqual(_events[i].result, 0);
+            _events[i].result = 1;
+            tamperedCount++;
+        }
+    }
+
+    MKAAssertEqual(tamperedCount, 1UL);
+    MKAAssertEqual(MKAFlightTestReplay(_events, eventCount).counts[MKAFlightReplayResultMismatched], 1UL);
+
+    // A suspension recorded with the other result is not reproduced either.
+    for (size_t i = 0; i < eventCount; i++) {
+        if (_events[i].type == MKAFlightEventTypeToastSuspend) {
+            _events[i].result = !_events[i].result;
+        }
+    }
+
+    MKAAssertEqual(MKAFlightTestReplay(_events, eventCount).counts[MKAFlightReplayResultMismatched], 2UL);
+}
+
+// MARK: - popup
+
+static void MKARecordPopupEvent(MKAPopupState *state, MKAPopupEvent event) {
+    const bool isAccepted = MKAPopupStateHandle(state, event);
+    MKAFlightTestRecord(state, (MKAFlightEventType) (MKAFlightEventTypePopupShow + event), isAccepted, 0, 0, 0, 0);
+}
+
+static void testPopupRoundTrip(void) {
+    MKAFlightTestSetUp();
+    MKAPopupState state = MKAPopupStateHidden;
+
+    // A hide before the show is rejected and skipped, since the lifecycle has not been started.
+    MKARecordPopupEvent(&state, MKAPopupEventHide);
+
+    for (int i = 0; i < 3; i++) {
+        MKARecordPopupEvent(&state, MKAPopupEventShow);
+        MKARecordPopupEvent(&state, MKAPopupEventShow);
+        MKARecordPopupEvent(&state, MKAPopupEventShowFinished);
+        MKAFlightTestRecord(&state, MKAFlightEventTypePopupDidAppear, 0, 0, 0, 0, 0);
+        MKARecordPopupEvent(&state, MKAPopupEventHide);
+        MKARecordPopupEvent(&state, MKAPopupEventHideFinished);
+        MKAFlightTestRecord(&state, MKAFlightEventTypePopupDidDisappear, 0, 0, 0, 0, 0);
+    }
+
+    const MKAReplayCounts counts = MKAFlightTestReplayRing();
+
+    MKAAssertEqual(counts.eventCount, 22UL);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultReproduced], 21UL);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultSkipped], 1UL);
+
+    // The rejected second show.
+    _events[2].result = 1;
+    MKAAssertEqual(MKAFlightTestReplay(_events, counts.eventCount).counts[MKAFlightReplayResultMismatched], 1UL);
+}
+
+// MARK: - indicator
+
+static MKAIndicatorLifecycle _indicator;
+
+static MKAIndicatorAction MKARecordIndicatorAction(MKAIndicatorAction action, MKAFlightEventType type, uint8_t flags) {
+    MKAFlightTestRecord(&_indicator,
+                        type,
+                        (uint8_t) action,
+                        _indicator.count,
+                        _indicator.gracePeriod,
+                        _indicator.minimumDisplayTime,
+                        flags);
+    return action;
+}
+
+static void MKAIndicatorMinimumDisplayTimeElapsedCallback(void *info) {
+    (void) info;
+    MKARecordIndicatorAction(MKAIndicatorLifecycleMinimumDisplayTimeElapsed(&_indicator),
+                             MKAFlightEventTypeIndicatorMinimumDisplayTimeElapsed,
+                             0);
+}
+
+static void MKAIndicatorGracePeriodElapsedCallback(void *info) {
+    (void) info;
+    MKARecordIndicatorAction(MKAIndicatorLifecycleGracePeriodElapsed(&_indicator, MKAClockNow(&_clock)),
+                             MKAFlightEventTypeIndicatorGracePeriodElapsed,
+                             0);
+}
+
+static void MKAIndicatorShow(bool usesGracePeriod) {
+    double delay;
+    const MKAIndicatorAction action = MKAIndicatorLifecycleShow(&_indicator, MKAClockNow(&_clock), usesGracePeriod, &delay);
+
+    if (MKARecordIndicatorAction(action, MKAFlightEventTypeIndicatorShow, usesGracePeriod) == MKAIndicatorActionSchedulePresent) {
+        MKAClockSchedule(&_clock, delay, MKAIndicatorGracePeriodElapsedCallback, NULL);
+    }
+}
+
+static void MKAIndicatorHide(void) {
+    double delay;
+    const MKAIndicatorAction action = MKAIndicatorLifecycleHide(&_indicator, MKAClockNow(&_clock), &delay);
+
+    if (MKARecordIndicatorAction(action, MKAFlightEventTypeIndicatorHide, 0) == MKAIndicatorActionScheduleDismiss) {
+        MKAClockSchedule(&_clock, delay, MKAIndicatorMinimumDisplayTimeElapsedCallback, NULL);
+    }
+}
+
+static void testIndicatorRoundTrip(void) {
+    MKAFlightTestSetUp();
+    MKAIndicatorLifecycleInit(&_indicator);
+    _indicator.gracePeriod = 0.5;
+    _indicator.minimumDisplayTime = 1;
+
+    // Nested callers past the grace period, hidden before the minimum display time.
+    MKAIndicatorShow(true);
+    MKAIndicatorShow(true);
+    MKAVirtualClockAdvance(&_virtualClock, 0.6);
+    MKAIndicatorHide();
+    MKAIndicatorHide();
+    MKAVirtualClockRunUntilIdle(&_virtualClock, 60);
+    MKAAssertEqual(_indicator.state, MKAIndicatorStateHidden);
+
+    // Hidden within the grace period, so it never appears.
+    MKAIndicatorShow(true);
+    MKAVirtualClockAdvance(&_virtualClock, 0.2);
+    MKAIndicatorHide();
+    MKAVirtualClockRunUntilIdle(&_virtualClock, 60);
+
+    // The properties are changed between the calls, then it is hidden forcibly.
+    _indicator.gracePeriod = 0;
+    _indicator.minimumDisplayTime = 0;
+    MKAIndicatorShow(false);
+    MKAIndicatorShow(false);
+    MKARecordIndicatorAction(MKAIndicatorLifecycleHideForcibly(&_indicator), MKAFlightEventTypeIndicatorHideForcibly, 0);
+    MKAAssertEqual(_indicator.count, 0U);
+
+    const MKAReplayCounts counts = MKAFlightTestReplayRing();
+
+    MKAAssert(counts.eventCount > 10);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultReproduced], counts.eventCount);
+
+    // A counter that does not match the lifecycle is not reproduced.
+    _events[1].count++;
+    MKAAssertEqual(MKAFlightTestReplay(_events, counts.eventCount).counts[MKAFlightReplayResultMismatched], 1UL);
+}
+
+// MARK: - replay
+
+static void testOverwrittenEventsAreSkipped(void) {
+    MKAFlightSlot slots[8];
+    MKAFlightEvent events[8];
+    MKAPopupState state = MKAPopupStateHidden;
+
+    MKAFlightTestSetUp();
+    MKAFlightRingInit(&_ring, slots, 8);
+    MKAFlightRingSetEnabled(&_ring, true);
+
+    // 10 events: the first show and show finished are overwritten.
+    MKARecordPopupEvent(&state, MKAPopupEventShow);
+    MKARecordPopupEvent(&state, MKAPopupEventShowFinished);
+    MKARecordPopupEvent(&state, MKAPopupEventHide);
+    MKARecordPopupEvent(&state, MKAPopupEventHideFinished);
+
+    for (int i = 0; i < 6; i++) {
+        MKARecordPopupEvent(&state, (MKAPopupEvent) (i % 4));
+    }
+
+    const size_t eventCount = MKAFlightRingCopyEvents(&_ring, events, 8);
+    const MKAReplayCounts counts = MKAFlightTestReplay(events, eventCount);
+
+    MKAAssertEqual(eventCount, 8UL);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultSkipped], 2UL);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultReproduced], 6UL);
+}
+
+static void testUnknownEventsAndFullTable(void) {
+    MKAFlightReplayComponent components[2];
+    MKAFlightReplay replay;
+    MKAFlightEvent event;
+
+    MKAFlightReplayInit(&replay, components, 2);
+    memset(&event, 0, sizeof(event));
+
+    event.type = 100;
+    MKAAssertEqual(MKAFlightReplayEvent(&replay, &event), MKAFlightReplayResultUnknown);
+    MKAAssertEqual(MKAFlightReplayKindOfType(100), MKAFlightReplayKindNone);
+    MKAAssert(strcmp(MKAFlightReplayNameOfType(100), "unknown") == 0);
+    MKAAssert(strcmp(MKAFlightReplayNameOfType(MKAFlightEventTypeToastShow), "toast show") == 0);
+
+    // A third component does not fit in the table.
+    event.type = MKAFlightEventTypePopupShow;
+    event.result = 1;
+
+    for (uint64_t object = 1; object <= 2; object++) {
+        event.object = object * 16;
+        MKAAssertEqual(MKAFlightReplayEvent(&replay, &event), MKAFlightReplayResultReproduced);
+    }
+
+    event.object = 48;
+    MKAAssertEqual(MKAFlightReplayEvent(&replay, &event), MKAFlightReplayResultSkipped);
+
+    // A reset forgets the components.
+    MKAFlightReplayReset(&replay);
+    MKAAssertEqual(MKAFlightReplayEvent(&replay, &event), MKAFlightReplayResultReproduced);
+}
+
+static void testReusedAddress(void) {
+    MKAFlightTestSetUp();
+    MKAPopupState state = MKAPopupStateHidden;
+
+    // A popup is deallocated while it is shown, and a toast is allocated at its address.
+    MKARecordPopupEvent(&state, MKAPopupEventShow);
+    MKAFlightTestRecord(&state, MKAFlightEventTypeToastShow, 1, 0, 1, 0, 0);
+    MKAFlightTestRecord(&state, MKAFlightEventTypeToastFadeInFinished, 1, 0, 0, 0, 0);
+    MKAFlightTestRecord(&state, MKAFlightEventTypeToastHide, 1, 0, 0, 0, 1);
+
+    const MKAReplayCounts counts = MKAFlightTestReplayRing();
+
+    MKAAssertEqual(counts.eventCount, 4UL);
+    MKAAssertEqual(counts.counts[MKAFlightReplayResultReproduced], 4UL);
+}
+
+// MARK: - dump
+
+/**
+ * Writes the toast sequence to the path, and a copy with a rejected hide recorded as accepted to the tampered path.
+ */
+static void MKAWriteDumps(const char *path, const char *tamperedPath) {
+    MKAToastDriver drivers[3];
+
+    MKAFlightTestSetUp();
+    MKARecordToastSequence(drivers);
+    MKAAssert(MKAFlightRingWriteFile(&_ring, path));
+
+    const size_t eventCount = MKAFlightRingCopyEvents(&_ring, _events, sizeof(_events) / sizeof(_events[0]));
+
+    MKAFlightRingInit(&_ring, _slots, sizeof(_slots) / sizeof(_slots[0]));
+    MKAFlightRingSetEnabled(&_ring, true);
+
+    for (size_t i = 0; i < eventCount; i++) {
+        if (_events[i].type == MKAFlightEventTypeToastHide && _events[i].result == 0) {
+            _events[i].result = 1;
+        }
+
+        MKAFlightRingRecord(&_ring, &_events[i]);
+    }
+
+    MKAAssert(MKAFlightRingWriteFile(&_ring, tamperedPath));
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 3) {
+        MKAWriteDumps(argv[1], argv[2]);
+        return MKATestExitStatus();
+    }
+
+    MKARunTest(testToastRoundTrip);
+    MKARunTest(testToastMismatch);
+    MKARunTest(testPopupRoundTrip);
+    MKARunTest(testIndicatorRoundTrip);
+
+    MKARunTest(testOverwrittenEventsAreSkipped);
+    MKARunTest(testUnknownEventsAndFullTable);
+    MKARunTest(testReusedAddress);
+
+    return MKATestExitStatus();
+}
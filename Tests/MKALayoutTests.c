@@ -0,0 +1,213 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKALayout.h"
+#include "MKATest.h"
+
+static const MKALayoutInsets kNoInsets = { 0, 0, 0, 0 };
+/**
+ * A notched phone in portrait: the status bar at the top and the home indicator at the bottom.
+ */
+static const MKALayoutInsets kPortraitInsets = { 47, 0, 34, 0 };
+/**
+ * The same phone in landscape: the notch on the left.
+ */
+static const MKALayoutInsets kLandscapeInsets = { 0, 47, 21, 47 };
+
+static void MKAAssertRect(MKALayoutRect rect, double x, double y, double width, double height) {
+    MKAAssertEqualDouble(rect.origin.x, x);
+    MKAAssertEqualDouble(rect.origin.y, y);
+    MKAAssertEqualDouble(rect.size.width, width);
+    MKAAssertEqualDouble(rect.size.height, height);
+}
+
+// MARK: - popup
+
+static void testPopupViewWithTitle(void) {
+    MKAPopupViewLayout layout = MKALayoutPopupView((MKALayoutSize) { 300, 400 }, (MKALayoutSize) { 100, 50 });
+
+    MKAAssertRect(layout.titleFrame, 100, 0, 100, 50);
+    MKAAssertRect(layout.containerFrame, 0, 50, 300, 350);
+}
+
+static void testPopupViewWithoutTitle(void) {
+    MKAPopupViewLayout layout = MKALayoutPopupView((MKALayoutSize) { 300, 400 }, (MKALayoutSize) { 0, 0 });
+
+    MKAAssertRect(layout.titleFrame, 150, 0, 0, 0);
+    MKAAssertRect(layout.containerFrame, 0, 0, 300, 400);
+}
+
+static void testPopupViewWithTallTitle(void) {
+    // The container is never negative when the title is taller than the popup view.
+    MKAPopupViewLayout layout = MKALayoutPopupView((MKALayoutSize) { 300, 40 }, (MKALayoutSize) { 100, 50 });
+
+    MKAAssertRect(layout.containerFrame, 0, 50, 300, 0);
+}
+
+static void testPopupCenter(void) {
+    const MKALayoutSize portrait = { 390, 844 };
+    const MKALayoutSize landscape = { 844, 390 };
+    MKALayoutPoint center;
+
+    center = MKALayoutPopupCenter(portrait, kNoInsets);
+    MKAAssertEqualDouble(center.x, 195);
+    MKAAssertEqualDouble(center.y, 422);
+
+    center = MKALayoutPopupCenter(portrait, kPortraitInsets);
+    MKAAssertEqualDouble(center.x, 195);
+    MKAAssertEqualDouble(center.y, 47 + (844 - 47 - 34) / 2.0);
+
+    center = MKALayoutPopupCenter(landscape, kLandscapeInsets);
+    MKAAssertEqualDouble(center.x, 422);
+    MKAAssertEqualDouble(center.y, (390 - 21) / 2.0);
+
+    // Each edge of the safe area moves the center away from it.
+    const MKALayoutInsets edges[] = { { 20, 0, 0, 0 }, { 0, 20, 0, 0 }, { 0, 0, 20, 0 }, { 0, 0, 0, 20 } };
+    const MKALayoutPoint centers[] = { { 195, 432 }, { 205, 422 }, { 195, 412 }, { 185, 422 } };
+
+    for (int i = 0; i < 4; i++) {
+        center = MKALayoutPopupCenter(portrait, edges[i]);
+        MKAAssertEqualDouble(center.x, centers[i].x);
+        MKAAssertEqualDouble(center.y, centers[i].y);
+    }
+}
+
+static void testClampPopupSize(void) {
+    const MKALayoutSize container = { 390, 844 };
+    MKALayoutSize size;
+
+    // Fits as it is.
+    size = MKALayoutClampPopupSize((MKALayoutSize) { 320, 480 }, container, kPortraitInsets);
+    MKAAssertEqualDouble(size.width, 320);
+    MKAAssertEqualDouble(size.height, 480);
+
+    // Too wide, too tall and both.
+    size = MKALayoutClampPopupSize((MKALayoutSize) { 500, 480 }, container, kNoInsets);
+    MKAAssertEqualDouble(size.width, 390);
+    MKAAssertEqualDouble(size.height, 480);
+
+    size = MKALayoutClampPopupSize((MKALayoutSize) { 320, 1000 }, container, kPortraitInsets);
+    MKAAssertEqualDouble(size.width, 320);
+    MKAAssertEqualDouble(size.height, 844 - 47 - 34);
+
+    size = MKALayoutClampPopupSize((MKALayoutSize) { 1000, 1000 }, (MKALayoutSize) { 844, 390 }, kLandscapeInsets);
+    MKAAssertEqualDouble(size.width, 844 - 47 - 47);
+    MKAAssertEqualDouble(size.height, 390 - 21);
+
+    // The safe area larger than the container leaves no room.
+    size = MKALayoutClampPopupSize((MKALayoutSize) { 320, 480 }, (MKALayoutSize) { 40, 40 }, kPortraitInsets);
+    MKAAssertEqualDouble(size.width, 40);
+    MKAAssertEqualDouble(size.height, 0);
+}
+
+static void testClampedPopupStaysOnScreen(void) {
+    const MKALayoutSize containers[] = { { 390, 844 }, { 844, 390 }, { 320, 568 } };
+    const MKALayoutInsets insets[] = { kNoInsets, kPortraitInsets, kLandscapeInsets };
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            MKALayoutSize size = MKALayoutClampPopupSize((MKALayoutSize) { 2000, 2000 }, containers[i], insets[j]);
+            MKALayoutPoint center = MKALayoutPopupCenter(containers[i], insets[j]);
+
+            MKAAssertEqualDouble(center.x - size.width / 2.0, insets[j].left);
+            MKAAssertEqualDouble(center.y - size.height / 2.0, insets[j].top);
+            MKAAssertEqualDouble(center.x + size.width / 2.0, containers[i].width - insets[j].right);
+            MKAAssertEqualDouble(center.y + size.height / 2.0, containers[i].height - insets[j].bottom);
+        }
+    }
+}
+
+// MARK: - bottom sheet
+
+static void testBottomSheet(void) {
+    MKAAssertRect(MKALayoutBottomSheet((MKALayoutSize) { 390, 844 }, 300, kNoInsets), 0, 544, 390, 300);
+
+    // Extends below the bottom safe area, so the content keeps the sheet height.
+    MKAAssertRect(MKALayoutBottomSheet((MKALayoutSize) { 390, 844 }, 300, kPortraitInsets), 0, 510, 390, 334);
+    MKAAssertRect(MKALayoutBottomSheet((MKALayoutSize) { 844, 390 }, 300, kLandscapeInsets), 0, 69, 844, 321);
+
+    // A negative height is clamped to zero.
+    MKAAssertRect(MKALayoutBottomSheet((MKALayoutSize) { 390, 844 }, -10, kNoInsets), 0, 844, 390, 0);
+}
+
+// MARK: - toast
+
+static void testToastLabel(void) {
+    MKAAssertEqualDouble(MKALayoutToastLabelWidth(300, 16), 268);
+    MKAAssertEqualDouble(MKALayoutToastLabelWidth(20, 16), 0);
+
+    MKAAssertRect(MKALayoutToastLabel((MKALayoutSize) { 300, 80 }, (MKALayoutSize) { 200, 20 }), 50, 30, 200, 20);
+    MKAAssertRect(MKALayoutToastLabel((MKALayoutSize) { 300, 80 }, (MKALayoutSize) { 0, 0 }), 150, 40, 0, 0);
+}
+
+static void testToastCenter(void) {
+    const MKALayoutSize toastSize = { 300, 80 };
+    MKALayoutPoint center;
+
+    center = MKALayoutToastCenter((MKALayoutSize) { 390, 844 }, toastSize, 64, kNoInsets);
+    MKAAssertEqualDouble(center.x, 195);
+    MKAAssertEqualDouble(center.y, 844 - 64 - 40);
+
+    center = MKALayoutToastCenter((MKALayoutSize) { 390, 844 }, toastSize, 64, kPortraitInsets);
+    MKAAssertEqualDouble(center.y, 844 - 34 - 64 - 40);
+
+    center = MKALayoutToastCenter((MKALayoutSize) { 844, 390 }, toastSize, 64, kLandscapeInsets);
+    MKAAssertEqualDouble(center.x, 422);
+    MKAAssertEqualDouble(center.y, 390 - 21 - 64 - 40);
+
+    // Asymmetric insets keep the toast centered in the safe area.
+    center = MKALayoutToastCenter((MKALayoutSize) { 844, 390 }, toastSize, 0, (MKALayoutInsets) { 0, 47, 0, 0 });
+    MKAAssertEqualDouble(center.x, 47 + (844 - 47) / 2.0);
+}
+
+static void testToastStack(void) {
+    const double heights[] = { 80, 40, 120 };
+    double offsets[] = { -1, -1, -1, -1 };
+
+    MKALayoutToastStack(heights, 3, 8, offsets);
+
+    MKAAssertEqualDouble(offsets[0], 0);
+    MKAAssertEqualDouble(offsets[1], 88);
+    MKAAssertEqualDouble(offsets[2], 136);
+    // Writes only `count` offsets.
+    MKAAssertEqualDouble(offsets[3], -1);
+
+    MKALayoutToastStack(heights, 0, 8, offsets);
+    MKAAssertEqualDouble(offsets[0], 0);
+}
+
+int main(void) {
+    MKARunTest(testPopupViewWithTitle);
+    MKARunTest(testPopupViewWithoutTitle);
+    MKARunTest(testPopupViewWithTallTitle);
+    MKARunTest(testPopupCenter);
+    MKARunTest(testClampPopupSize);
+    MKARunTest(testClampedPopupStaysOnScreen);
+    MKARunTest(testBottomSheet);
+    MKARunTest(testToastLabel);
+    MKARunTest(testToastCenter);
+    MKARunTest(testToastStack);
+
+    return MKATestExitStatus();
+}
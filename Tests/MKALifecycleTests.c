@@ -0,0 +1,429 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKALifecycle.h"
+#include "MKATest.h"
+
+// MARK: - popup
+
+static const MKAPopupState kPopupStates[] = {
+    MKAPopupStateHidden, MKAPopupStateShowing, MKAPopupStateShown, MKAPopupStateHiding,
+};
+
+static const MKAPopupEvent kPopupEvents[] = {
+    MKAPopupEventShow, MKAPopupEventShowFinished, MKAPopupEventHide, MKAPopupEventHideFinished,
+};
+
+/**
+ * The next state of each state and event. -1 means that the transition is illegal.
+ */
+static const int kPopupTransitions[4][4] = {
+    // Show,                 ShowFinished,       Hide,                HideFinished
+    { MKAPopupStateShowing, -1,                 -1,                  -1 },                   // Hidden
+    { -1,                   MKAPopupStateShown, MKAPopupStateHiding, -1 },                   // Showing
+    { -1,                   -1,                 MKAPopupStateHiding, -1 },                   // Shown
+    { -1,                   -1,                 -1,                  MKAPopupStateHidden },  // Hiding
+};
+
+static void testPopupTransitions(void) {
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            MKAPopupState state = kPopupStates[i];
+            const bool isAccepted = MKAPopupStateHandle(&state, kPopupEvents[j]);
+            const bool isLegal = kPopupTransitions[i][j] >= 0;
+
+            MKAAssertEqual(isAccepted, isLegal);
+            MKAAssertEqual(MKAPopupStateCanHandle(kPopupStates[i], kPopupEvents[j]), isLegal);
+            MKAAssertEqual((int) state, isLegal ? kPopupTransitions[i][j] : (int) kPopupStates[i]);
+        }
+    }
+}
+
+static void testPopupFullCycle(void) {
+    MKAPopupState state = MKAPopupStateHidden;
+
+    MKAAssert(MKAPopupStateHandle(&state, MKAPopupEventShow));
+    MKAAssert(!MKAPopupStateHandle(&state, MKAPopupEventShow));
+    MKAAssert(MKAPopupStateHandle(&state, MKAPopupEventShowFinished));
+    MKAAssert(MKAPopupStateHandle(&state, MKAPopupEventHide));
+    MKAAssert(!MKAPopupStateHandle(&state, MKAPopupEventHide));
+    MKAAssert(MKAPopupStateHandle(&state, MKAPopupEventHideFinished));
+    MKAAssertEqual(state, MKAPopupStateHidden);
+}
+
+// MARK: - toast
+
+static const MKAToastState kToastStates[] = {
+    MKAToastStateIdle, MKAToastStateFadingIn, MKAToastStateHolding, MKAToastStateFadingOut, MKAToastStateFinished,
+};
+
+/**
+ * Drives a toast displayed for 2 seconds into given state through the legal transitions from time 0.
+ */
+static MKAToastLifecycle MKAToastLifecycleMake(MKAToastState state) {
+    MKAToastLifecycle lifecycle;
+    double delay;
+
+    MKAToastLifecycleInit(&lifecycle, 2);
+
+    if (state == MKAToastStateIdle) {
+        return lifecycle;
+    }
+
+    MKAToastLifecycleShow(&lifecycle);
+
+    if (state == MKAToastStateFadingIn) {
+        return lifecycle;
+    }
+
+    MKAToastLifecycleFadeInFinished(&lifecycle, 0, &delay);
+
+    if (state == MKAToastStateHolding) {
+        return lifecycle;
+    }
+
+    MKAToastLifecycleHide(&lifecycle, false);
+
+    if (state == MKAToastStateFadingOut) {
+        return lifecycle;
+    }
+
+    MKAToastLifecycleFadeOutFinished(&lifecycle);
+
+    return lifecycle;
+}
+
+static void testToastShow(void) {
+    for (int i = 0; i < 5; i++) {
+        MKAToastLifecycle lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+        const bool isLegal = kToastStates[i] == MKAToastStateIdle || kToastStates[i] == MKAToastStateFinished;
+
+        MKAAssertEqual(MKAToastLifecycleShow(&lifecycle), isLegal);
+        MKAAssertEqual(lifecycle.state, isLegal ? MKAToastStateFadingIn : kToastStates[i]);
+    }
+}
+
+static void testToastFadeInFinished(void) {
+    for (int i = 0; i < 5; i++) {
+        MKAToastLifecycle lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+        const bool isLegal = kToastStates[i] == MKAToastStateFadingIn;
+        double delay = -1;
+
+        MKAAssertEqual(MKAToastLifecycleFadeInFinished(&lifecycle, 1, &delay), isLegal);
+        MKAAssertEqual(lifecycle.state, isLegal ? MKAToastStateHolding : kToastStates[i]);
+        MKAAssertEqualDouble(delay, isLegal ? 2 : -1);
+    }
+}
+
+static void testToastHideManually(void) {
+    for (int i = 0; i < 5; i++) {
+        MKAToastLifecycle lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+        const bool isLegal = kToastStates[i] == MKAToastStateFadingIn || kToastStates[i] == MKAToastStateHolding;
+
+        MKAAssertEqual(MKAToastLifecycleHide(&lifecycle, true), isLegal);
+        MKAAssertEqual(lifecycle.state, isLegal ? MKAToastStateFadingOut : kToastStates[i]);
+    }
+}
+
+static void testToastHideByTimer(void) {
+    for (int i = 0; i < 5; i++) {
+        MKAToastLifecycle lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+        const bool isLegal = kToastStates[i] == MKAToastStateHolding;
+
+        MKAAssertEqual(MKAToastLifecycleHide(&lifecycle, false), isLegal);
+        MKAAssertEqual(lifecycle.state, isLegal ? MKAToastStateFadingOut : kToastStates[i]);
+    }
+
+    // A stale timer fired while the toast is suspended does not hide it.
+    MKAToastLifecycle lifecycle = MKAToastLifecycleMake(MKAToastStateHolding);
+    MKAToastLifecycleSuspend(&lifecycle, 1);
+
+    MKAAssert(!MKAToastLifecycleHide(&lifecycle, false));
+    MKAAssertEqual(lifecycle.state, MKAToastStateHolding);
+}
+
+static void testToastFadeOutFinished(void) {
+    for (int i = 0; i < 5; i++) {
+        MKAToastLifecycle lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+        const bool isLegal = kToastStates[i] == MKAToastStateFadingOut;
+
+        MKAAssertEqual(MKAToastLifecycleFadeOutFinished(&lifecycle), isLegal);
+        MKAAssertEqual(lifecycle.state, isLegal ? MKAToastStateFinished : kToastStates[i]);
+    }
+}
+
+static void testToastCancel(void) {
+    for (int i = 0; i < 5; i++) {
+        MKAToastLifecycle lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+
+        MKAAssertEqual(MKAToastLifecycleCancel(&lifecycle), kToastStates[i]);
+        MKAAssertEqual(lifecycle.state, kToastStates[i] == MKAToastStateIdle ? MKAToastStateIdle : MKAToastStateFinished);
+        MKAAssert(!lifecycle.isHoldTimerRunning);
+        MKAAssert(!lifecycle.isSuspended);
+    }
+}
+
+static void testToastSuspendAndResume(void) {
+    MKAToastLifecycle lifecycle = MKAToastLifecycleMake(MKAToastStateHolding);
+    double delay = 0;
+
+    // The hold timer started at 0 is stopped at 0.5 with 1.5 seconds left.
+    MKAAssert(MKAToastLifecycleSuspend(&lifecycle, 0.5));
+    MKAAssert(!MKAToastLifecycleSuspend(&lifecycle, 0.6));
+    MKAAssertEqualDouble(lifecycle.remainingTime, 1.5);
+
+    MKAAssert(MKAToastLifecycleResume(&lifecycle, 10, &delay));
+    MKAAssert(!MKAToastLifecycleResume(&lifecycle, 10, &delay));
+    MKAAssertEqualDouble(delay, 1.5);
+    MKAAssertEqualDouble(lifecycle.holdStartTime, 10);
+
+    // A toast suspended while fading in starts its timer when it is resumed after the fade.
+    lifecycle = MKAToastLifecycleMake(MKAToastStateFadingIn);
+
+    MKAAssert(!MKAToastLifecycleSuspend(&lifecycle, 0));
+    MKAAssert(!MKAToastLifecycleFadeInFinished(&lifecycle, 1, &delay));
+    MKAAssert(MKAToastLifecycleResume(&lifecycle, 3, &delay));
+    MKAAssertEqualDouble(delay, 2);
+
+    // Nothing is left to resume for other states.
+    for (int i = 0; i < 5; i++) {
+        if (kToastStates[i] == MKAToastStateHolding || kToastStates[i] == MKAToastStateFadingIn) {
+            continue;
+        }
+
+        lifecycle = MKAToastLifecycleMake(kToastStates[i]);
+
+        MKAAssert(!MKAToastLifecycleSuspend(&lifecycle, 0));
+        MKAAssert(!MKAToastLifecycleResume(&lifecycle, 1, &delay));
+        MKAAssertEqual(lifecycle.state, kToastStates[i]);
+    }
+}
+
+static void testToastForever(void) {
+    MKAToastLifecycle lifecycle;
+    double delay = -1;
+
+    MKAToastLifecycleInit(&lifecycle, -1);
+
+    MKAAssert(MKAToastLifecycleShow(&lifecycle));
+    MKAAssert(!MKAToastLifecycleFadeInFinished(&lifecycle, 0, &delay));
+    MKAAssertEqual(lifecycle.state, MKAToastStateHolding);
+    MKAAssert(!MKAToastLifecycleHide(&lifecycle, false));
+    MKAAssert(MKAToastLifecycleHide(&lifecycle, true));
+    MKAAssertEqualDouble(delay, -1);
+}
+
+// MARK: - indicator
+
+static const MKAIndicatorState kIndicatorStates[] = {
+    MKAIndicatorStateHidden, MKAIndicatorStatePending, MKAIndicatorStatePresented, MKAIndicatorStateLingering,
+};
+
+/**
+ * Drives an indicator with the grace period of 1 second and the minimum display time of 2 seconds into given state
+ * through the legal transitions from time 0. Its counter is 1 while it is pending or presented, otherwise 0.
+ */
+static MKAIndicatorLifecycle MKAIndicatorLifecycleMake(MKAIndicatorState state) {
+    MKAIndicatorLifecycle lifecycle;
+    double delay;
+
+    MKAIndicatorLifecycleInit(&lifecycle);
+    lifecycle.gracePeriod = 1;
+    lifecycle.minimumDisplayTime = 2;
+
+    switch (state) {
+        case MKAIndicatorStateHidden:
+            break;
+        case MKAIndicatorStatePending:
+            MKAIndicatorLifecycleShow(&lifecycle, 0, true, &delay);
+            break;
+        case MKAIndicatorStatePresented:
+            MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay);
+            break;
+        case MKAIndicatorStateLingering:
+            MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay);
+            MKAIndicatorLifecycleHide(&lifecycle, 0.5, &delay);
+            break;
+    }
+
+    return lifecycle;
+}
+
+typedef struct MKAIndicatorTransition {
+    MKAIndicatorAction action;
+    MKAIndicatorState state;
+} MKAIndicatorTransition;
+
+static void MKAAssertIndicatorTransitions(MKAIndicatorAction (*transition)(MKAIndicatorLifecycle *lifecycle),
+                                          const MKAIndicatorTransition expected[4]) {
+    for (int i = 0; i < 4; i++) {
+        MKAIndicatorLifecycle lifecycle = MKAIndicatorLifecycleMake(kIndicatorStates[i]);
+
+        MKAAssertEqual(transition(&lifecycle), expected[i].action);
+        MKAAssertEqual(lifecycle.state, expected[i].state);
+    }
+}
+
+static MKAIndicatorAction MKAIndicatorShowWithGracePeriod(MKAIndicatorLifecycle *lifecycle) {
+    double delay;
+    return MKAIndicatorLifecycleShow(lifecycle, 1, true, &delay);
+}
+
+static MKAIndicatorAction MKAIndicatorShowWithoutGracePeriod(MKAIndicatorLifecycle *lifecycle) {
+    double delay;
+    return MKAIndicatorLifecycleShow(lifecycle, 1, false, &delay);
+}
+
+static MKAIndicatorAction MKAIndicatorHide(MKAIndicatorLifecycle *lifecycle) {
+    double delay;
+    return MKAIndicatorLifecycleHide(lifecycle, 1, &delay);
+}
+
+static MKAIndicatorAction MKAIndicatorGracePeriodElapsed(MKAIndicatorLifecycle *lifecycle) {
+    return MKAIndicatorLifecycleGracePeriodElapsed(lifecycle, 1);
+}
+
+static void testIndicatorShow(void) {
+    MKAAssertIndicatorTransitions(MKAIndicatorShowWithGracePeriod, (MKAIndicatorTransition[]) {
+        { MKAIndicatorActionSchedulePresent, MKAIndicatorStatePending },
+        { MKAIndicatorActionNone, MKAIndicatorStatePending },
+        { MKAIndicatorActionNone, MKAIndicatorStatePresented },
+        { MKAIndicatorActionCancelScheduled, MKAIndicatorStatePresented },
+    });
+    MKAAssertIndicatorTransitions(MKAIndicatorShowWithoutGracePeriod, (MKAIndicatorTransition[]) {
+        { MKAIndicatorActionPresent, MKAIndicatorStatePresented },
+        { MKAIndicatorActionNone, MKAIndicatorStatePending },
+        { MKAIndicatorActionNone, MKAIndicatorStatePresented },
+        { MKAIndicatorActionCancelScheduled, MKAIndicatorStatePresented },
+    });
+
+    // The grace period is skipped when it is zero.
+    MKAIndicatorLifecycle lifecycle = MKAIndicatorLifecycleMake(MKAIndicatorStateHidden);
+    lifecycle.gracePeriod = 0;
+
+    MKAAssertEqual(MKAIndicatorShowWithGracePeriod(&lifecycle), MKAIndicatorActionPresent);
+    MKAAssertEqualDouble(lifecycle.presentedTime, 1);
+}
+
+static void testIndicatorHide(void) {
+    MKAAssertIndicatorTransitions(MKAIndicatorHide, (MKAIndicatorTransition[]) {
+        { MKAIndicatorActionNone, MKAIndicatorStateHidden },
+        { MKAIndicatorActionCancelScheduled, MKAIndicatorStateHidden },
+        { MKAIndicatorActionScheduleDismiss, MKAIndicatorStateLingering },
+        { MKAIndicatorActionNone, MKAIndicatorStateLingering },
+    });
+
+    MKAIndicatorLifecycle lifecycle = MKAIndicatorLifecycleMake(MKAIndicatorStatePresented);
+    double delay = 0;
+
+    // Lingers for the rest of the minimum display time.
+    MKAAssertEqual(MKAIndicatorLifecycleHide(&lifecycle, 0.5, &delay), MKAIndicatorActionScheduleDismiss);
+    MKAAssertEqualDouble(delay, 1.5);
+
+    // Dismisses at once after the minimum display time.
+    lifecycle = MKAIndicatorLifecycleMake(MKAIndicatorStatePresented);
+
+    MKAAssertEqual(MKAIndicatorLifecycleHide(&lifecycle, 2, &delay), MKAIndicatorActionDismiss);
+    MKAAssertEqual(lifecycle.state, MKAIndicatorStateHidden);
+
+    // A hide within the grace period is counted as skipped.
+    lifecycle = MKAIndicatorLifecycleMake(MKAIndicatorStatePending);
+
+    MKAIndicatorHide(&lifecycle);
+    MKAAssertEqual(lifecycle.skippedShowCount, 1UL);
+    MKAAssertEqual(lifecycle.count, 0UL);
+}
+
+static void testIndicatorHideForcibly(void) {
+    MKAAssertIndicatorTransitions(MKAIndicatorLifecycleHideForcibly, (MKAIndicatorTransition[]) {
+        { MKAIndicatorActionNone, MKAIndicatorStateHidden },
+        { MKAIndicatorActionCancelScheduled, MKAIndicatorStateHidden },
+        { MKAIndicatorActionDismiss, MKAIndicatorStateHidden },
+        { MKAIndicatorActionDismiss, MKAIndicatorStateHidden },
+    });
+
+    MKAIndicatorLifecycle lifecycle = MKAIndicatorLifecycleMake(MKAIndicatorStatePresented);
+    MKAIndicatorShowWithoutGracePeriod(&lifecycle);
+    MKAIndicatorLifecycleHideForcibly(&lifecycle);
+
+    MKAAssertEqual(lifecycle.count, 0UL);
+    MKAAssertEqual(lifecycle.skippedShowCount, 0UL);
+}
+
+static void testIndicatorGracePeriodElapsed(void) {
+    MKAAssertIndicatorTransitions(MKAIndicatorGracePeriodElapsed, (MKAIndicatorTransition[]) {
+        { MKAIndicatorActionNone, MKAIndicatorStateHidden },
+        { MKAIndicatorActionPresent, MKAIndicatorStatePresented },
+        { MKAIndicatorActionNone, MKAIndicatorStatePresented },
+        { MKAIndicatorActionNone, MKAIndicatorStateLingering },
+    });
+}
+
+static void testIndicatorMinimumDisplayTimeElapsed(void) {
+    MKAAssertIndicatorTransitions(MKAIndicatorLifecycleMinimumDisplayTimeElapsed, (MKAIndicatorTransition[]) {
+        { MKAIndicatorActionNone, MKAIndicatorStateHidden },
+        { MKAIndicatorActionNone, MKAIndicatorStatePending },
+        { MKAIndicatorActionNone, MKAIndicatorStatePresented },
+        { MKAIndicatorActionDismiss, MKAIndicatorStateHidden },
+    });
+}
+
+static void testIndicatorNestedShows(void) {
+    MKAIndicatorLifecycle lifecycle = MKAIndicatorLifecycleMake(MKAIndicatorStateHidden);
+    double delay;
+
+    MKAAssertEqual(MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay), MKAIndicatorActionPresent);
+    MKAAssertEqual(MKAIndicatorLifecycleShow(&lifecycle, 0, false, &delay), MKAIndicatorActionNone);
+    MKAAssertEqual(MKAIndicatorLifecycleHide(&lifecycle, 5, &delay), MKAIndicatorActionNone);
+    MKAAssert(MKAIndicatorLifecycleIsPresented(&lifecycle));
+    MKAAssertEqual(MKAIndicatorLifecycleHide(&lifecycle, 5, &delay), MKAIndicatorActionDismiss);
+    MKAAssert(!MKAIndicatorLifecycleIsPresented(&lifecycle));
+
+    // An extra hide does not make the counter negative.
+    MKAAssertEqual(MKAIndicatorLifecycleHide(&lifecycle, 5, &delay), MKAIndicatorActionNone);
+    MKAAssertEqual(lifecycle.count, 0UL);
+}
+
+int main(void) {
+    MKARunTest(testPopupTransitions);
+    MKARunTest(testPopupFullCycle);
+
+    MKARunTest(testToastShow);
+    MKARunTest(testToastFadeInFinished);
+    MKARunTest(testToastHideManually);
+    MKARunTest(testToastHideByTimer);
+    MKARunTest(testToastFadeOutFinished);
+    MKARunTest(testToastCancel);
+    MKARunTest(testToastSuspendAndResume);
+    MKARunTest(testToastForever);
+
+    MKARunTest(testIndicatorShow);
+    MKARunTest(testIndicatorHide);
+    MKARunTest(testIndicatorHideForcibly);
+    MKARunTest(testIndicatorGracePeriodElapsed);
+    MKARunTest(testIndicatorMinimumDisplayTimeElapsed);
+    MKARunTest(testIndicatorNestedShows);
+
+    return MKATestExitStatus();
+}
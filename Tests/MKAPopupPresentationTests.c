@@ -0,0 +1,216 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKAPopupPresentation.h"
+#include "MKATest.h"
+
+/**
+ * Distinct addresses standing for the views.
+ */
+static char _rootView, _popup, _popupView;
+
+static MKARenderEvent _events[16];
+static MKARenderRecorder _recorder;
+static MKARenderBackend _backend;
+
+static const MKALayoutSize kRootSize = { 390, 844 };
+static const MKALayoutInsets kNoInsets = { 0, 0, 0, 0 };
+
+static MKAPopupPresentation MKAPopupPresentationMake(MKAPopupPlacement placement) {
+    MKAPopupPresentation presentation;
+
+    MKAPopupPresentationInit(&presentation, &_popup, &_popupView, placement);
+    presentation.popupSize = (MKALayoutSize) { 320, 480 };
+
+    MKARenderRecorderInit(&_recorder, _events, sizeof(_events) / sizeof(_events[0]), NULL);
+    _backend = MKARenderRecorderBackend(&_recorder);
+
+    return presentation;
+}
+
+static void MKAAssertCounts(size_t insertions, size_t removals, size_t constraintActivations, size_t frameChanges, size_t animations) {
+    MKAAssertEqual(_recorder.counts.insertions, insertions);
+    MKAAssertEqual(_recorder.counts.removals, removals);
+    MKAAssertEqual(_recorder.counts.constraintActivations, constraintActivations);
+    MKAAssertEqual(_recorder.counts.frameChanges, frameChanges);
+    MKAAssertEqual(_recorder.counts.animations, animations);
+}
+
+static void testShowBudget(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+
+    MKAAssert(MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3));
+
+    // 1 insertion, 0 constraint activations and 1 animation. The frames are the background and the popup view.
+    MKAAssertCounts(1, 0, 0, 2, 1);
+    MKAAssertEqual(_recorder.eventCount, 4UL);
+
+    MKAAssertEqual(_events[0].type, MKARenderEventTypeInsert);
+    MKAAssert(_events[0].node == &_popup);
+    MKAAssert(_events[0].parent == &_rootView);
+
+    MKAAssertEqual(_events[1].type, MKARenderEventTypeSetFrame);
+    MKAAssert(_events[1].node == &_popup);
+    MKAAssertEqualDouble(_events[1].frame.size.width, 390);
+    MKAAssertEqualDouble(_events[1].frame.size.height, 844);
+
+    MKAAssertEqual(_events[2].type, MKARenderEventTypeSetFrame);
+    MKAAssert(_events[2].node == &_popupView);
+    MKAAssertEqualDouble(_events[2].frame.origin.x, 35);
+    MKAAssertEqualDouble(_events[2].frame.origin.y, 182);
+
+    MKAAssertEqual(_events[3].type, MKARenderEventTypeBeginAnimation);
+    MKAAssert(_events[3].node == &_popup);
+    MKAAssertEqualDouble(_events[3].duration, 0.3);
+
+    // The end of the animation renders nothing.
+    MKARenderRecorderReset(&_recorder);
+
+    MKAAssert(MKAPopupPresentationShowFinished(&presentation));
+    MKAAssertCounts(0, 0, 0, 0, 0);
+    MKAAssertEqual(presentation.state, MKAPopupStateShown);
+}
+
+static void testHideBudget(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+
+    MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3);
+    MKAPopupPresentationShowFinished(&presentation);
+    MKARenderRecorderReset(&_recorder);
+
+    MKAAssert(MKAPopupPresentationHide(&presentation, &_backend, 0.3));
+    MKAAssertCounts(0, 0, 0, 0, 1);
+
+    MKAAssert(MKAPopupPresentationHideFinished(&presentation, &_backend));
+    MKAAssertCounts(0, 1, 0, 0, 1);
+    MKAAssert(_events[1].node == &_popup);
+    MKAAssertEqual(presentation.state, MKAPopupStateHidden);
+}
+
+static void testIllegalEventsRenderNothing(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+
+    MKAAssert(!MKAPopupPresentationHide(&presentation, &_backend, 0.3));
+    MKAAssert(!MKAPopupPresentationHideFinished(&presentation, &_backend));
+    MKAAssert(!MKAPopupPresentationShowFinished(&presentation));
+    MKAAssertCounts(0, 0, 0, 0, 0);
+
+    MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3);
+    MKARenderRecorderReset(&_recorder);
+
+    // A second show while showing does not insert the popup again.
+    MKAAssert(!MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3));
+    MKAAssert(!MKAPopupPresentationHideFinished(&presentation, &_backend));
+    MKAAssertCounts(0, 0, 0, 0, 0);
+}
+
+static void testHideWhileShowing(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+
+    MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3);
+
+    MKAAssert(MKAPopupPresentationHide(&presentation, &_backend, 0.3));
+    // The end of the showing animation is ignored after hiding started.
+    MKAAssert(!MKAPopupPresentationShowFinished(&presentation));
+    MKAAssert(MKAPopupPresentationHideFinished(&presentation, &_backend));
+    MKAAssertCounts(1, 1, 0, 2, 2);
+}
+
+static void testRepeatedShowsDoNotAddWork(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+    const size_t count = 1000;
+
+    for (size_t i = 0; i < count; i++) {
+        MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3);
+        MKAPopupPresentationShowFinished(&presentation);
+        MKAPopupPresentationHide(&presentation, &_backend, 0.3);
+        MKAPopupPresentationHideFinished(&presentation, &_backend);
+    }
+
+    MKAAssertCounts(count, count, 0, 2 * count, 2 * count);
+}
+
+static void testBottomPlacement(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementBottom);
+    presentation.popupSize = (MKALayoutSize) { 0, 300 };
+
+    MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3);
+
+    MKAAssertCounts(1, 0, 0, 2, 1);
+    MKAAssert(_events[2].node == &_popupView);
+    MKAAssertEqualDouble(_events[2].frame.origin.x, 0);
+    MKAAssertEqualDouble(_events[2].frame.origin.y, 544);
+    MKAAssertEqualDouble(_events[2].frame.size.width, 390);
+    MKAAssertEqualDouble(_events[2].frame.size.height, 300);
+}
+
+static void testLayout(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+
+    // Rotation lays out the popup view only.
+    MKAPopupPresentationLayout(&presentation, &_backend, (MKALayoutSize) { 844, 390 }, (MKALayoutInsets) { 0, 47, 21, 47 });
+
+    MKAAssertCounts(0, 0, 0, 1, 0);
+    MKAAssertEqualDouble(_events[0].frame.origin.x, 262);
+    MKAAssertEqualDouble(_events[0].frame.origin.y, (390 - 21) / 2.0 - 240);
+}
+
+static void testRecorderForwarding(void) {
+    MKARenderRecorder next;
+    MKARenderRecorderInit(&next, NULL, 0, NULL);
+    const MKARenderBackend nextBackend = MKARenderRecorderBackend(&next);
+
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+    MKARenderRecorderInit(&_recorder, _events, 16, &nextBackend);
+
+    MKAPopupPresentationShow(&presentation, &_backend, &_rootView, kRootSize, kNoInsets, 0.3);
+
+    MKAAssertEqual(next.counts.insertions, 1UL);
+    MKAAssertEqual(next.counts.frameChanges, 2UL);
+    MKAAssertEqual(next.counts.animations, 1UL);
+    MKAAssertEqual(next.eventCount, 0UL);
+}
+
+static void testNullBackend(void) {
+    MKAPopupPresentation presentation = MKAPopupPresentationMake(MKAPopupPlacementCenter);
+    const MKARenderBackend backend = MKARenderBackendNull();
+
+    MKAAssert(MKAPopupPresentationShow(&presentation, &backend, &_rootView, kRootSize, kNoInsets, 0.3));
+    MKAAssert(MKAPopupPresentationHide(&presentation, NULL, 0.3));
+    MKAAssert(MKAPopupPresentationHideFinished(&presentation, &backend));
+}
+
+int main(void) {
+    MKARunTest(testShowBudget);
+    MKARunTest(testHideBudget);
+    MKARunTest(testIllegalEventsRenderNothing);
+    MKARunTest(testHideWhileShowing);
+    MKARunTest(testRepeatedShowsDoNotAddWork);
+    MKARunTest(testBottomPlacement);
+    MKARunTest(testLayout);
+    MKARunTest(testRecorderForwarding);
+    MKARunTest(testNullBackend);
+
+    return MKATestExitStatus();
+}
@@ -0,0 +1,61 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#ifndef MKATest_h
+#define MKATest_h
+
+#include <math.h>
+#include <stdio.h>
+
+/*
+ * A minimal test harness. A failed assertion prints its location and the test goes on,
+ * so one run reports all failures. `main` returns `MKATestExitStatus()`.
+ */
+
+static int MKATestFailureCount = 0;
+
+#define MKAAssert(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+            MKATestFailureCount++; \
+        } \
+    } while (0)
+
+#define MKAAssertEqual(actual, expected) MKAAssert((actual) == (expected))
+
+#define MKAAssertEqualDouble(actual, expected) MKAAssert(fabs((double) (actual) - (double) (expected)) < 1e-9)
+
+#define MKARunTest(test) \
+    do { \
+        const int failureCount = MKATestFailureCount; \
+        test(); \
+        printf("%s %s\n", failureCount == MKATestFailureCount ? "PASS" : "FAIL", #test); \
+    } while (0)
+
+static inline int MKATestExitStatus(void) {
+    return MKATestFailureCount > 0 ? 1 : 0;
+}
+
+#endif /* MKATest_h */
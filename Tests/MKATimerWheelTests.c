@@ -0,0 +1,274 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+#include "MKATimerWheel.h"
+#include "MKATest.h"
+
+static MKATimerWheelEntry _slots[8];
+static MKATimerWheelEntry _entries[4];
+static MKATimerWheel _wheel;
+
+/**
+ * The order of the fired timers.
+ */
+static int _fired[16];
+static int _firedCount;
+
+static void MKATimerWheelTestSetUp(void) {
+    // 8 slots of 1 second: a rotation is 8 seconds.
+    MKATimerWheelInit(&_wheel, _slots, 8, _entries, 4, 1, 0);
+    _firedCount = 0;
+}
+
+static void MKARecordFiring(void *info) {
+    _fired[_firedCount++] = *(const int *) info;
+}
+
+// MARK: - arming and firing
+
+static void testFiresOnFirstTickAfterDeadline(void) {
+    MKATimerWheelTestSetUp();
+    int first = 1, second = 2;
+
+    MKAAssert(MKATimerWheelArm(&_wheel, 0, 1.5, MKARecordFiring, &first) != 0);
+    MKAAssert(MKATimerWheelArm(&_wheel, 0, 2, MKARecordFiring, &second) != 0);
+    MKAAssertEqual(_wheel.count, 2UL);
+
+    // The deadline 1.5 is rounded up to the tick 2.
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 1.9), 0UL);
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 2), 2UL);
+    MKAAssertEqual(_fired[0], 1);
+    MKAAssertEqual(_fired[1], 2);
+    MKAAssertEqual(_wheel.count, 0UL);
+}
+
+static void testZeroDelayFiresOnNextTick(void) {
+    MKATimerWheelTestSetUp();
+    int info = 1;
+
+    MKATimerWheelAdvance(&_wheel, 3.5);
+    MKATimerWheelArm(&_wheel, 3.5, -1, MKARecordFiring, &info);
+
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 3.9), 0UL);
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 4), 1UL);
+}
+
+static void testLaterRounds(void) {
+    MKATimerWheelTestSetUp();
+    int near = 1, far = 2;
+
+    // The tick 3 and the tick 11 share the slot 3.
+    MKATimerWheelArm(&_wheel, 0, 11, MKARecordFiring, &far);
+    MKATimerWheelArm(&_wheel, 0, 3, MKARecordFiring, &near);
+
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 3), 1UL);
+    MKAAssertEqual(_fired[0], 1);
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 10), 0UL);
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 11), 1UL);
+    MKAAssertEqual(_fired[1], 2);
+}
+
+static void testJumpBeyondRotation(void) {
+    MKATimerWheelTestSetUp();
+    int late = 1, early = 2, sameTick = 3, nextRound = 5;
+
+    // The slot of the tick 10 is visited before the slot of the tick 3.
+    MKATimerWheelArm(&_wheel, 0, 10, MKARecordFiring, &late);
+    MKATimerWheelArm(&_wheel, 0, 3, MKARecordFiring, &early);
+    MKATimerWheelArm(&_wheel, 0, 2.5, MKARecordFiring, &sameTick);
+    MKATimerWheelArm(&_wheel, 0, 30, MKARecordFiring, &nextRound);
+
+    // Each slot is visited once, and the timers fire in the order of their deadlines and then of arming.
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 20), 3UL);
+    MKAAssertEqual(_fired[0], 2);
+    MKAAssertEqual(_fired[1], 3);
+    MKAAssertEqual(_fired[2], 1);
+    MKAAssertEqual(_wheel.currentTick, 20ULL);
+
+    // The timer of a later round stays armed.
+    MKAAssertEqual(_wheel.count, 1UL);
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 29), 0UL);
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 30), 1UL);
+    MKAAssertEqual(_fired[3], 5);
+}
+
+// MARK: - cancellation
+
+static void testCancel(void) {
+    MKATimerWheelTestSetUp();
+    int first = 1, second = 2;
+
+    const MKAClockTimer timer = MKATimerWheelArm(&_wheel, 0, 1, MKARecordFiring, &first);
+    MKATimerWheelArm(&_wheel, 0, 1, MKARecordFiring, &second);
+
+    MKAAssert(MKATimerWheelCancel(&_wheel, timer));
+    MKAAssert(!MKATimerWheelCancel(&_wheel, timer));
+    MKAAssert(!MKATimerWheelCancel(&_wheel, 0));
+    MKAAssert(!MKATimerWheelCancel(&_wheel, 100));
+
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 1), 1UL);
+    MKAAssertEqual(_fired[0], 2);
+}
+
+static void testStaleTimerDoesNotCancelReusedEntry(void) {
+    MKATimerWheelTestSetUp();
+    int info = 1;
+
+    const MKAClockTimer stale = MKATimerWheelArm(&_wheel, 0, 1, MKARecordFiring, &info);
+    MKATimerWheelAdvance(&_wheel, 1);
+
+    // The entry is reused with another generation.
+    const MKAClockTimer timer = MKATimerWheelArm(&_wheel, 1, 1, MKARecordFiring, &info);
+    MKAAssertEqual(timer & 0xffffffff, stale & 0xffffffff);
+    MKAAssert(timer != stale);
+
+    MKAAssert(!MKATimerWheelCancel(&_wheel, stale));
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 2), 1UL);
+}
+
+static void testCapacity(void) {
+    MKATimerWheelTestSetUp();
+    int info = 1;
+
+    for (int i = 0; i < 4; i++) {
+        MKAAssert(MKATimerWheelArm(&_wheel, 0, i, MKARecordFiring, &info) != 0);
+    }
+
+    MKAAssertEqual(MKATimerWheelArm(&_wheel, 0, 1, MKARecordFiring, &info), 0ULL);
+    MKAAssertEqual(_wheel.count, 4UL);
+
+    // A fired entry is available again.
+    MKATimerWheelAdvance(&_wheel, 1);
+    MKAAssert(MKATimerWheelArm(&_wheel, 1, 1, MKARecordFiring, &info) != 0);
+    MKAAssertEqual(MKATimerWheelArm(&_wheel, 1, 1, NULL, &info), 0ULL);
+}
+
+// MARK: - callbacks
+
+static MKAClockTimer _canceledTimer;
+static int _rearmedInfo = 9;
+
+static void MKACancelAndRearm(void *info) {
+    MKARecordFiring(info);
+    // Cancels a timer expired on the same tick, and arms another one for a later tick.
+    MKATimerWheelCancel(&_wheel, _canceledTimer);
+    MKATimerWheelArm(&_wheel, (double) _wheel.currentTick, 0, MKARecordFiring, &_rearmedInfo);
+}
+
+static void testCallbacksCancelAndArm(void) {
+    MKATimerWheelTestSetUp();
+    int first = 1, second = 2;
+
+    MKATimerWheelArm(&_wheel, 0, 1, MKACancelAndRearm, &first);
+    _canceledTimer = MKATimerWheelArm(&_wheel, 0, 1, MKARecordFiring, &second);
+
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 1), 1UL);
+    MKAAssertEqual(_firedCount, 1);
+    MKAAssertEqual(_wheel.count, 1UL);
+
+    MKAAssertEqual(MKATimerWheelAdvance(&_wheel, 2), 1UL);
+    MKAAssertEqual(_fired[1], 9);
+}
+
+// MARK: - next deadline
+
+static void testNextDeadline(void) {
+    MKATimerWheelTestSetUp();
+    int info = 1;
+    double deadline = -1;
+
+    MKAAssert(!MKATimerWheelNextDeadline(&_wheel, &deadline));
+    MKAAssertEqualDouble(deadline, -1);
+
+    const MKAClockTimer timer = MKATimerWheelArm(&_wheel, 0, 5.2, MKARecordFiring, &info);
+    MKATimerWheelArm(&_wheel, 0, 7, MKARecordFiring, &info);
+
+    MKAAssert(MKATimerWheelNextDeadline(&_wheel, &deadline));
+    MKAAssertEqualDouble(deadline, 6);
+
+    MKATimerWheelCancel(&_wheel, timer);
+    MKAAssert(MKATimerWheelNextDeadline(&_wheel, &deadline));
+    MKAAssertEqualDouble(deadline, 7);
+
+    MKATimerWheelAdvance(&_wheel, 7);
+    MKAAssert(!MKATimerWheelNextDeadline(&_wheel, &deadline));
+}
+
+static void testNextDeadlineOfLaterRounds(void) {
+    MKATimerWheelTestSetUp();
+    int info = 1;
+    double deadline;
+
+    // No timer is due in the current round: the earliest of the later rounds is found.
+    MKATimerWheelArm(&_wheel, 0, 26, MKARecordFiring, &info);
+    MKATimerWheelArm(&_wheel, 0, 19, MKARecordFiring, &info);
+    MKAAssert(MKATimerWheelNextDeadline(&_wheel, &deadline));
+    MKAAssertEqualDouble(deadline, 19);
+
+    // The timer of the current round in the slot 1 comes before the later round in the slot 3.
+    MKATimerWheelArm(&_wheel, 0, 1, MKARecordFiring, &info);
+    MKAAssert(MKATimerWheelNextDeadline(&_wheel, &deadline));
+    MKAAssertEqualDouble(deadline, 1);
+
+    MKATimerWheelAdvance(&_wheel, 1);
+    MKATimerWheelArm(&_wheel, 1, 9.5, MKARecordFiring, &info);
+    MKAAssert(MKATimerWheelNextDeadline(&_wheel, &deadline));
+    MKAAssertEqualDouble(deadline, 11);
+}
+
+static void testNextDeadlineWithStartTime(void) {
+    MKATimerWheelEntry slots[256];
+    MKATimerWheelEntry entries[4];
+    MKATimerWheel wheel;
+    int info = 1;
+    double deadline;
+
+    MKATimerWheelInit(&wheel, slots, 256, entries, 4, 0.25, 100);
+    MKATimerWheelArm(&wheel, 100.1, 0.3, MKARecordFiring, &info);
+
+    MKAAssert(MKATimerWheelNextDeadline(&wheel, &deadline));
+    MKAAssertEqualDouble(deadline, 100.5);
+
+    // Advancing to the deadline fires the timer.
+    MKAAssertEqual(MKATimerWheelAdvance(&wheel, deadline), 1UL);
+}
+
+int main(void) {
+    MKARunTest(testFiresOnFirstTickAfterDeadline);
+    MKARunTest(testZeroDelayFiresOnNextTick);
+    MKARunTest(testLaterRounds);
+    MKARunTest(testJumpBeyondRotation);
+
+    MKARunTest(testCancel);
+    MKARunTest(testStaleTimerDoesNotCancelReusedEntry);
+    MKARunTest(testCapacity);
+
+    MKARunTest(testCallbacksCancelAndArm);
+
+    MKARunTest(testNextDeadline);
+    MKARunTest(testNextDeadlineOfLaterRounds);
+    MKARunTest(testNextDeadlineWithStartTime);
+
+    return MKATestExitStatus();
+}
@@ -0,0 +1,239 @@
+//
+// MIT License
+//
+// Copyright (c) 2020-present Hituzi Ando
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/*
+ * Replays a dump of MKAFlightRecorder through the lifecycle functions without UIKit, and reports the events
+ * whose recorded results are not reproduced. It runs on any platform with a C11 compiler:
+ *
+ *     cmake -S . -B build && cmake --build build
+ *     ./build/Tools/MKAFlightReplay/mka-flight-replay [-v] [-r repeats] dump.bin
+ *
+ * The dump must be read on a machine with the same byte order as the recording one.
+ * The replay itself is `MKAFlightReplay` of the core, which the unit tests run on recorded sequences.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "MKAFlightReplay.h"
+#include "MKAFlightRing.h"
+
+// MARK: - replay
+
+typedef struct MKAReplayStatistics {
+    uint64_t counts[UINT16_MAX + 1];
+    uint64_t mismatches[UINT16_MAX + 1];
+    uint64_t skippedCount;
+    uint64_t unknownCount;
+} MKAReplayStatistics;
+
+static void MKAReplayEvents(const MKAFlightEvent *events,
+                            size_t count,
+                            MKAFlightReplay *replay,
+                            MKAReplayStatistics *statistics,
+                            bool isVerbose) {
+    for (size_t i = 0; i < count; i++) {
+        const MKAFlightEvent *event = &events[i];
+
+        statistics->counts[event->type]++;
+
+        switch (MKAFlightReplayEvent(replay, event)) {
+            case MKAFlightReplayResultReproduced:
+                break;
+            case MKAFlightReplayResultMismatched:
+                statistics->mismatches[event->type]++;
+
+                if (isVerbose) {
+                    fprintf(stderr,
+                            "mismatch: #%zu %.6f 0x%016llx %s result=%u count=%u\n",
+                            i,
+                            event->time,
+                            (unsigned long long) event->object,
+                            MKAFlightReplayNameOfType(event->type),
+                            event->result,
+                            event->count);
+                }
+
+                break;
+            case MKAFlightReplayResultSkipped:
+                statistics->skippedCount++;
+                break;
+            case MKAFlightReplayResultUnknown:
+                statistics->unknownCount++;
+                break;
+        }
+    }
+}
+
+// MARK: - dump
+
+static MKAFlightEvent *MKAReplayReadDump(const char *path, size_t *count) {
+    FILE *file = fopen(path, "rb");
+
+    if (!file) {
+        fprintf(stderr, "%s: can not be opened\n", path);
+        return NULL;
+    }
+
+    MKAFlightDumpHeader header;
+    MKAFlightEvent *events = NULL;
+
+    if (fread(&header, sizeof(header), 1, file) != 1
+        || memcmp(header.magic, MKAFlightDumpMagic, sizeof(header.magic)) != 0) {
+        fprintf(stderr, "%s: not a flight recorder dump\n", path);
+    }
+    else if (header.version != MKAFlightDumpVersion || header.eventSize != sizeof(MKAFlightEvent)) {
+        fprintf(stderr, "%s: unsupported version %u with the event size %u\n", path, header.version, header.eventSize);
+    }
+    else if (header.eventCount > SIZE_MAX / sizeof(MKAFlightEvent)) {
+        fprintf(stderr, "%s: too many events\n", path);
+    }
+    else {
+        // Allocates one event at least, since malloc may return NULL for zero.
+        events = malloc(header.eventCount > 0 ? (size_t) header.eventCount * sizeof(MKAFlightEvent) : 1);
+
+        if (events && fread(events, sizeof(MKAFlightEvent), (size_t) header.eventCount, file) != header.eventCount) {
+            fprintf(stderr, "%s: truncated\n", path);
+            free(events);
+            events = NULL;
+        }
+    }
+
+    fclose(file);
+    *count = events ? (size_t) header.eventCount : 0;
+
+    return events;
+}
+
+// MARK: - main
+
+static double MKAReplayNow(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (double) time.tv_sec + (double) time.tv_nsec / 1e9;
+}
+
+static void MKAReplayPrintUsage(const char *name) {
+    fprintf(stderr, "usage: %s [-v] [-r repeats] dump\n", name);
+}
+
+int main(int argc, char *argv[]) {
+    const char *path = NULL;
+    unsigned long repeatCount = 1;
+    bool isVerbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            isVerbose = true;
+        }
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            repeatCount = strtoul(argv[++i], NULL, 10);
+        }
+        else if (!path && argv[i][0] != '-') {
+            path = argv[i];
+        }
+        else {
+            MKAReplayPrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (!path || repeatCount == 0) {
+        MKAReplayPrintUsage(argv[0]);
+        return 2;
+    }
+
+    size_t eventCount = 0;
+    MKAFlightEvent *events = MKAReplayReadDump(path, &eventCount);
+    MKAReplayStatistics *statistics = calloc(1, sizeof(MKAReplayStatistics));
+    // The table is twice as large as the number of the events at least, so every component has an element.
+    size_t capacity = 16;
+
+    while (capacity < eventCount * 2) {
+        capacity *= 2;
+    }
+
+    MKAFlightReplayComponent *components = calloc(capacity, sizeof(MKAFlightReplayComponent));
+
+    if (!events || !statistics || !components) {
+        free(events);
+        free(statistics);
+        free(components);
+        return 1;
+    }
+
+    MKAFlightReplay replay;
+    MKAFlightReplayInit(&replay, components, capacity);
+
+    // Repeats the replay to measure the cost of the lifecycle functions. Only the first pass is reported.
+    double elapsedTime = 0;
+
+    for (unsigned long i = 0; i < repeatCount; i++) {
+        MKAFlightReplayReset(&replay);
+
+        const double startTime = MKAReplayNow();
+        MKAReplayEvents(events, eventCount, &replay, statistics, isVerbose && i == 0);
+        elapsedTime += MKAReplayNow() - startTime;
+
+        if (i == 0) {
+            printf("%-40s %10s %10s\n", "event", "count", "mismatch");
+
+            for (size_t type = 0; type <= UINT16_MAX; type++) {
+                if (statistics->counts[type] > 0) {
+                    printf("%-40s %10llu %10llu\n",
+                           MKAFlightReplayNameOfType((uint16_t) type),
+                           (unsigned long long) statistics->counts[type],
+                           (unsigned long long) statistics->mismatches[type]);
+                }
+            }
+        }
+    }
+
+    uint64_t mismatchCount = 0;
+
+    for (size_t type = 0; type <= UINT16_MAX; type++) {
+        mismatchCount += statistics->mismatches[type];
+    }
+
+    // The statistics are accumulated over the repeats.
+    printf("\n%zu events, %llu skipped, %llu unknown, %llu mismatches\n",
+           eventCount,
+           (unsigned long long) (statistics->skippedCount / repeatCount),
+           (unsigned long long) (statistics->unknownCount / repeatCount),
+           (unsigned long long) (mismatchCount / repeatCount));
+    printf("%.3f us per pass, %.1f ns per event\n",
+           elapsedTime / (double) repeatCount * 1e6,
+           eventCount > 0 ? elapsedTime / (double) repeatCount / (double) eventCount * 1e9 : 0.0);
+
+    free(components);
+    free(statistics);
+    free(events);
+
+    return mismatchCount > 0 ? 1 : 0;
+}